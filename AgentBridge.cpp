@@ -0,0 +1,431 @@
+#include "AgentBridge.h"
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const char* const SHARED_MEMORY_PREFIX{ "tetris-bridge-" };
+
+		void Relax()
+		{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			_mm_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+
+		// Sleeps until counter may have moved on from seen. Spurious returns
+		// are fine, the callers check again.
+		void SleepOn(std::atomic<uint32_t>& counter, uint32_t seen)
+		{
+#if defined(__linux__)
+			timespec timeout{ 0, 10000000 };
+
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAIT, seen, &timeout, nullptr, 0);
+#elif defined(_WIN32)
+			(void)counter;
+			(void)seen;
+			::Sleep(1);
+#else
+			(void)counter;
+			(void)seen;
+			timespec pause{ 0, 100000 };
+
+			nanosleep(&pause, nullptr);
+#endif
+		}
+
+		void Wake(std::atomic<uint32_t>& counter)
+		{
+#if defined(__linux__)
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+			(void)counter;
+#endif
+		}
+
+		// Stores value and wakes whoever sleeps on the counter. The waiters
+		// count is only read after the store, and a waiter only sleeps after
+		// raising it, so a wake is never lost and a pair that keeps up with
+		// each other never makes a system call.
+		void Advance(BridgeMemory& memory, std::atomic<uint32_t>& counter, uint32_t value)
+		{
+			counter.store(value);
+
+			if (memory.waiters.load() > 0)
+			{
+				Wake(counter);
+			}
+		}
+
+		// Spinning only helps when the other side runs on another core.
+		int GetSpinCount()
+		{
+			static const int spinCount{ std::thread::hardware_concurrency() > 1 ? AGENT_BRIDGE_SPIN_COUNT : 0 };
+
+			return spinCount;
+		}
+
+		void WaitForChange(BridgeMemory& memory, std::atomic<uint32_t>& counter, uint32_t seen, uint32_t closedFlag)
+		{
+			for (int i{}; i < GetSpinCount(); i++)
+			{
+				if (counter.load(std::memory_order_acquire) != seen
+					|| (memory.closedSides.load(std::memory_order_acquire) & closedFlag) != 0)
+				{
+					return;
+				}
+
+				Relax();
+			}
+
+			memory.waiters.fetch_add(1);
+
+			if (counter.load() == seen && (memory.closedSides.load() & closedFlag) == 0)
+			{
+				SleepOn(counter, seen);
+			}
+
+			memory.waiters.fetch_sub(1);
+		}
+	}
+
+	bool GetBridgeMovement(const BridgeAction& action, PieceMovement& movement)
+	{
+		if (action.movement <= static_cast<int>(PieceMovement::None)
+			|| action.movement > static_cast<int>(PieceMovement::HardDrop))
+		{
+			return false;
+		}
+
+		movement = (PieceMovement)action.movement;
+
+		return true;
+	}
+
+	AgentBridge::~AgentBridge()
+	{
+		Close();
+	}
+
+	bool AgentBridge::Host(const char* name)
+	{
+		Close();
+
+		if (!Map(name, true))
+		{
+			return false;
+		}
+
+		isHost = true;
+		memory->version = AGENT_BRIDGE_VERSION;
+		memory->ringSize = AGENT_BRIDGE_RING_SIZE;
+		memory->stateSize = sizeof(BridgeState);
+		std::atomic_thread_fence(std::memory_order_release);
+		memory->magic = AGENT_BRIDGE_MAGIC;
+
+		return true;
+	}
+
+	bool AgentBridge::Join(const char* name)
+	{
+		Close();
+
+		if (!Map(name, false))
+		{
+			return false;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (memory->magic != AGENT_BRIDGE_MAGIC || memory->version != AGENT_BRIDGE_VERSION
+			|| memory->ringSize != AGENT_BRIDGE_RING_SIZE || memory->stateSize != sizeof(BridgeState)
+			|| (memory->closedSides.load() & AGENT_BRIDGE_HOST_CLOSED) != 0)
+		{
+			Close();
+			return false;
+		}
+
+		isHost = false;
+		seenStates = 0;
+
+		return true;
+	}
+
+	void AgentBridge::Close()
+	{
+		if (memory == nullptr)
+		{
+			return;
+		}
+
+		memory->closedSides.fetch_or(isHost ? AGENT_BRIDGE_HOST_CLOSED : AGENT_BRIDGE_AGENT_CLOSED);
+		Wake(memory->publishedStates);
+		Wake(memory->sentActions);
+		Wake(memory->receivedActions);
+
+#if defined(_WIN32)
+		UnmapViewOfFile(memory);
+		CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+		munmap(memory, sizeof(BridgeMemory));
+
+		if (isHost)
+		{
+			shm_unlink(("/" + std::string{ SHARED_MEMORY_PREFIX } + name).c_str());
+		}
+#endif
+
+		memory = nullptr;
+		handle = -1;
+	}
+
+	bool AgentBridge::IsOpen() const
+	{
+		return memory != nullptr;
+	}
+
+	bool AgentBridge::IsPeerClosed() const
+	{
+		return memory == nullptr || (memory->closedSides.load(std::memory_order_acquire) & GetPeerClosedFlag()) != 0;
+	}
+
+	void AgentBridge::PublishState(const Engine& engine, long long games)
+	{
+		uint32_t sequence{ memory->publishedStates.load(std::memory_order_relaxed) + 1 };
+
+		// Zero marks a slot being written, so it is never a sequence.
+		if (sequence == 0)
+		{
+			sequence = 1;
+		}
+
+		BridgeState& state{ memory->states[sequence % AGENT_BRIDGE_RING_SIZE] };
+		const Bitboard& board{ engine.GetBoard() };
+		BridgeStateData data{};
+
+		data.score = engine.GetScore();
+		data.lockedPieces = engine.GetLockedPieces();
+		data.clearedLines = engine.GetClearedLines();
+		data.games = games;
+
+		for (int i{}; i < BOARD_HEIGHT_IN_BLOCKS; i++)
+		{
+			data.rows[i] = board.GetRow(i);
+		}
+
+		data.figure = (int8_t)engine.GetCurrentFigure();
+		data.rotation = (int8_t)engine.GetRotation();
+		data.nextFigure = (int8_t)engine.GetNextFigure();
+		data.nextRotation = (int8_t)engine.GetNextRotation();
+		data.x = (int8_t)engine.GetPosition().x;
+		data.y = (int8_t)engine.GetPosition().y;
+		data.isGameOver = engine.IsGameOver() ? 1 : 0;
+
+		state.sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		std::memcpy(&state.data, &data, sizeof(data));
+		state.sequence.store(sequence, std::memory_order_release);
+		Advance(*memory, memory->publishedStates, sequence);
+	}
+
+	bool AgentBridge::TryReceiveAction(BridgeAction& action)
+	{
+		uint32_t received{ memory->receivedActions.load(std::memory_order_relaxed) };
+
+		if (memory->sentActions.load(std::memory_order_acquire) == received)
+		{
+			return false;
+		}
+
+		action = memory->actions[received % AGENT_BRIDGE_RING_SIZE];
+		Advance(*memory, memory->receivedActions, received + 1);
+
+		return true;
+	}
+
+	bool AgentBridge::WaitForAction(BridgeAction& action)
+	{
+		for (;;)
+		{
+			uint32_t sent{ memory->sentActions.load(std::memory_order_acquire) };
+
+			if (TryReceiveAction(action))
+			{
+				return true;
+			}
+
+			if (IsPeerClosed())
+			{
+				return false;
+			}
+
+			WaitForChange(*memory, memory->sentActions, sent, AGENT_BRIDGE_AGENT_CLOSED);
+		}
+	}
+
+	bool AgentBridge::WaitForState(BridgeStateData& data, uint32_t& sequence)
+	{
+		for (;;)
+		{
+			uint32_t published{ memory->publishedStates.load(std::memory_order_acquire) };
+
+			if (published != seenStates)
+			{
+				const BridgeState& state{ memory->states[published % AGENT_BRIDGE_RING_SIZE] };
+
+				seenStates = published;
+				sequence = state.sequence.load(std::memory_order_acquire);
+				std::memcpy(&data, &state.data, sizeof(data));
+				std::atomic_thread_fence(std::memory_order_acquire);
+
+				if (state.sequence.load(std::memory_order_relaxed) != sequence)
+				{
+					sequence = 0;
+				}
+
+				return true;
+			}
+
+			if (IsPeerClosed())
+			{
+				return false;
+			}
+
+			WaitForChange(*memory, memory->publishedStates, published, AGENT_BRIDGE_HOST_CLOSED);
+		}
+	}
+
+	bool AgentBridge::SendAction(const BridgeAction& action)
+	{
+		uint32_t sent{ memory->sentActions.load(std::memory_order_relaxed) };
+
+		for (;;)
+		{
+			uint32_t received{ memory->receivedActions.load(std::memory_order_acquire) };
+
+			if (sent - received < AGENT_BRIDGE_RING_SIZE)
+			{
+				break;
+			}
+
+			if (IsPeerClosed())
+			{
+				return false;
+			}
+
+			WaitForChange(*memory, memory->receivedActions, received, AGENT_BRIDGE_HOST_CLOSED);
+		}
+
+		memory->actions[sent % AGENT_BRIDGE_RING_SIZE] = action;
+		Advance(*memory, memory->sentActions, sent + 1);
+
+		return true;
+	}
+
+	bool AgentBridge::Map(const char* name, bool isCreating)
+	{
+		std::string path{ std::string{ SHARED_MEMORY_PREFIX } + name };
+		void* address{};
+
+#if defined(_WIN32)
+		std::string mappingName{ "Local\\" + path };
+		HANDLE mapping{ isCreating
+			? CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(BridgeMemory),
+				mappingName.c_str())
+			: OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str()) };
+
+		// Like O_EXCL: a bridge of the same name is still in use.
+		if (mapping != nullptr && isCreating && GetLastError() == ERROR_ALREADY_EXISTS)
+		{
+			CloseHandle(mapping);
+			return false;
+		}
+
+		if (mapping == nullptr)
+		{
+			return false;
+		}
+
+		address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(BridgeMemory));
+
+		if (address == nullptr)
+		{
+			CloseHandle(mapping);
+			return false;
+		}
+
+		handle = reinterpret_cast<intptr_t>(mapping);
+#else
+		path.insert(0, "/");
+
+		// O_EXCL keeps a second host from wiping a bridge that is in use.
+		int descriptor{ shm_open(path.c_str(), isCreating ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600) };
+		struct stat status{};
+
+		if (descriptor < 0)
+		{
+			return false;
+		}
+
+		if ((isCreating && ftruncate(descriptor, sizeof(BridgeMemory)) != 0)
+			|| fstat(descriptor, &status) != 0 || (size_t)status.st_size < sizeof(BridgeMemory))
+		{
+			address = MAP_FAILED;
+		}
+		else
+		{
+			address = mmap(nullptr, sizeof(BridgeMemory), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		}
+
+		close(descriptor);
+
+		if (address == MAP_FAILED)
+		{
+			if (isCreating)
+			{
+				shm_unlink(path.c_str());
+			}
+
+			return false;
+		}
+#endif
+
+		// A new mapping is all zeros, which is a valid empty bridge.
+		memory = static_cast<BridgeMemory*>(address);
+		this->name = name;
+
+		return true;
+	}
+
+	uint32_t AgentBridge::GetPeerClosedFlag() const
+	{
+		return isHost ? AGENT_BRIDGE_AGENT_CLOSED : AGENT_BRIDGE_HOST_CLOSED;
+	}
+}
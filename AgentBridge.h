@@ -0,0 +1,130 @@
+#pragma once
+#include "Engine.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace GameNamespace
+{
+	const uint32_t
+		AGENT_BRIDGE_MAGIC{ 0x47524254 },
+		AGENT_BRIDGE_VERSION{ 1 },
+		AGENT_BRIDGE_RING_SIZE{ 64 },
+		AGENT_BRIDGE_HOST_CLOSED{ 1 },
+		AGENT_BRIDGE_AGENT_CLOSED{ 2 };
+
+	const int
+		AGENT_BRIDGE_SPIN_COUNT{ 2000 },
+		AGENT_BRIDGE_RESET{ -1 };
+
+	// One logic tick of the game as the agent sees it. Rows are Bitboard
+	// rows, walls and floor included.
+	struct BridgeStateData
+	{
+		int64_t lockedPieces;
+		int64_t clearedLines;
+		int64_t games;
+		int32_t score;
+		uint16_t rows[BOARD_HEIGHT_IN_BLOCKS];
+		int8_t figure;
+		int8_t rotation;
+		int8_t nextFigure;
+		int8_t nextRotation;
+		int8_t x;
+		int8_t y;
+		int8_t isGameOver;
+	};
+
+	// A slot of the state ring. The data is only copied in and out whole,
+	// between fences. sequence is stored last, after the data, and is zero
+	// while the slot is being written.
+	struct BridgeState
+	{
+		std::atomic<uint32_t> sequence;
+		BridgeStateData data;
+		int8_t reserved[32];
+	};
+
+	// A PieceMovement, or AGENT_BRIDGE_RESET to start a new game, with the
+	// sequence of the state it answers.
+	struct BridgeAction
+	{
+		uint32_t stateSequence;
+		int32_t movement;
+	};
+
+	// The shared memory itself. The counters only grow; state N lives in
+	// states[N % AGENT_BRIDGE_RING_SIZE] and action N in actions[N % ...].
+	struct BridgeMemory
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t ringSize;
+		uint32_t stateSize;
+		alignas(64) std::atomic<uint32_t> publishedStates;
+		alignas(64) std::atomic<uint32_t> sentActions;
+		alignas(64) std::atomic<uint32_t> receivedActions;
+		alignas(64) std::atomic<uint32_t> closedSides;
+		alignas(64) std::atomic<uint32_t> waiters;
+		alignas(64) BridgeState states[AGENT_BRIDGE_RING_SIZE];
+		BridgeAction actions[AGENT_BRIDGE_RING_SIZE];
+	};
+
+	// The movement an action asks for, if any. None is no input rather than a
+	// movement: next to other inputs of a tick it would add a gravity step
+	// that a replay, which never records None, does not repeat.
+	bool GetBridgeMovement(const BridgeAction& action, PieceMovement& movement);
+
+	static_assert(sizeof(BridgeState) == 128, "BridgeState is part of the shared memory layout");
+	static_assert(std::atomic<uint32_t>::is_always_lock_free, "The bridge needs lock-free counters");
+
+	// Connects the game to an agent in another process through a named
+	// shared memory ring: POSIX shm_open on Linux and macOS, a named file
+	// mapping on Windows. The host publishes a state every tick and reads
+	// actions back; the agent does the opposite and reads states in place.
+	//
+	// Waiting spins for a while and then sleeps on the counter it waits for,
+	// with a futex on Linux, so a waiting side costs nothing and a busy pair
+	// never enters the kernel. Either side may close at any time; the other
+	// stops waiting when it does.
+	class AgentBridge
+	{
+	public:
+		AgentBridge() = default;
+		~AgentBridge();
+
+		AgentBridge(const AgentBridge&) = delete;
+		AgentBridge& operator=(const AgentBridge&) = delete;
+
+		// Fails if a bridge of that name exists, even one left behind by a
+		// host that crashed.
+		bool Host(const char* name);
+		bool Join(const char* name);
+		void Close();
+		bool IsOpen() const;
+		bool IsPeerClosed() const;
+
+		void PublishState(const Engine& engine, long long games);
+		bool TryReceiveAction(BridgeAction& action);
+		// Returns false once the agent has closed the bridge.
+		bool WaitForAction(BridgeAction& action);
+
+		// Copies out the newest state not returned before. When the host does
+		// not wait for actions the slot may be rewritten while it is copied;
+		// sequence is zero for such a torn copy. Returns false once the host
+		// has closed the bridge.
+		bool WaitForState(BridgeStateData& data, uint32_t& sequence);
+		bool SendAction(const BridgeAction& action);
+
+	private:
+		BridgeMemory* memory{};
+		std::string name{};
+		bool isHost{};
+		uint32_t seenStates{};
+		intptr_t handle{ -1 };
+
+		bool Map(const char* name, bool isCreating);
+		uint32_t GetPeerClosedFlag() const;
+	};
+}
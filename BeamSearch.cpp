@@ -0,0 +1,312 @@
+#include "BeamSearch.h"
+#include <algorithm>
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const PiecePosition SPAWN_POSITION{ PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW };
+
+		// The value of the last level depends on the lines cleared on the way
+		// as well as on the board.
+		uint64_t GetExpectationKey(const Bitboard& board, int clearedLines)
+		{
+			return board.GetHash() ^ (uint64_t)(clearedLines + 1) * 0xD6E8FEB86659FD93ull;
+		}
+	}
+
+	double BeamSearchStatistics::GetNodesPerSecond() const
+	{
+		return seconds > 0 ? nodes / seconds : 0;
+	}
+
+	double BeamSearchStatistics::GetAverageLevels() const
+	{
+		return searches > 0 ? (double)completedLevels / searches : 0;
+	}
+
+	double BeamSearchStatistics::GetAverageBeamSize() const
+	{
+		return searches > 0 ? (double)expandedBeamNodes / searches : 0;
+	}
+
+	double BeamSearchStatistics::GetTranspositionHitRate() const
+	{
+		return transpositionProbes > 0 ? (double)transpositionHits / transpositionProbes : 0;
+	}
+
+	BeamSearch::BeamSearch(int threads, int beamWidth, EvaluationWeights weights, size_t transpositionMegabytes)
+		: beamWidth{ beamWidth }, weights{ weights }, pool{ threads }
+	{
+		if (transpositionMegabytes > 0)
+		{
+			transpositionTable = std::make_unique<TranspositionTable>(transpositionMegabytes);
+		}
+
+		// The children of the workers and nextBeam are not reserved: they grow
+		// during the first searches and keep their capacity afterwards.
+		for (int i{}; i < pool.GetThreadCount(); i++)
+		{
+			workers.push_back(std::make_unique<Worker>());
+		}
+
+		rootPlacements.reserve(MAX_PLACEMENTS);
+		beam.reserve(MAX_PLACEMENTS);
+		values.resize(std::max(beamWidth, MAX_PLACEMENTS));
+		isCompleted.resize(values.size());
+	}
+
+	int BeamSearch::Search(const Engine& engine, std::chrono::steady_clock::time_point deadline, Placement& placement)
+	{
+		auto start{ std::chrono::steady_clock::now() };
+		const Bitboard& board{ engine.GetBoard() };
+		FigureKind figure{ engine.GetCurrentFigure() };
+		int levels{};
+		bool isDeadlineHit{};
+
+		statistics.searches++;
+
+		for (std::unique_ptr<Worker>& worker : workers)
+		{
+			worker->nodes = 0;
+			worker->transpositionProbes = 0;
+			worker->transpositionHits = 0;
+		}
+
+		if (transpositionTable)
+		{
+			transpositionTable->NewGeneration();
+		}
+
+		// The current piece is always searched in full, on this thread, so
+		// there is an answer even if the deadline has already passed.
+		int count{ rootGenerator.Generate(board, figure, engine.GetRotation(), engine.GetPosition()) };
+
+		rootPlacements.clear();
+		beam.clear();
+
+		for (int i{}; i < count; i++)
+		{
+			const Placement& rootPlacement{ rootGenerator.GetPlacement(i) };
+			BeamNode node{ board, i };
+
+			node.board.Place(figure, rootPlacement.rotation, rootPlacement.x, rootPlacement.y);
+			node.clearedLines = node.board.ClearFullRows().count;
+			node.score = EvaluateBoard(node.board, node.clearedLines, weights);
+
+			rootPlacements.push_back(rootPlacement);
+			beam.push_back(node);
+		}
+
+		if (count > 0)
+		{
+			KeepBestNodes(beam);
+			placement = rootPlacements[beam[0].firstPlacement];
+			levels++;
+		}
+
+		for (int level{ 1 }; level < BEAM_SEARCH_LEVELS && levels == level; level++)
+		{
+			if (std::chrono::steady_clock::now() >= deadline)
+			{
+				isDeadlineHit = true;
+				break;
+			}
+
+			bool isPieceKnown{ level == 1 };
+			int completed{ SearchLevel(engine.GetNextFigure(), engine.GetNextRotation(), isPieceKnown, deadline) };
+			int best{ -1 };
+
+			for (int i{}; i < (int)beam.size(); i++)
+			{
+				if (isCompleted[i] && (best < 0 || values[i] > values[best]))
+				{
+					best = i;
+				}
+			}
+
+			isDeadlineHit = isDeadlineHit || completed < (int)beam.size();
+			statistics.expandedBeamNodes += completed;
+
+			if (best < 0)
+			{
+				break;
+			}
+
+			placement = rootPlacements[beam[best].firstPlacement];
+			levels++;
+
+			// Merging the children is only worth it if the next level can
+			// still start.
+			if (isPieceKnown && std::chrono::steady_clock::now() < deadline)
+			{
+				nextBeam.clear();
+
+				for (std::unique_ptr<Worker>& worker : workers)
+				{
+					nextBeam.insert(nextBeam.end(), worker->children.begin(), worker->children.end());
+				}
+
+				KeepBestNodes(nextBeam);
+				beam.swap(nextBeam);
+			}
+		}
+
+		statistics.nodes += count;
+
+		for (std::unique_ptr<Worker>& worker : workers)
+		{
+			statistics.nodes += worker->nodes;
+			statistics.transpositionProbes += worker->transpositionProbes;
+			statistics.transpositionHits += worker->transpositionHits;
+		}
+
+		statistics.completedLevels += levels;
+		statistics.deadlineHits += isDeadlineHit ? 1 : 0;
+		statistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		return levels;
+	}
+
+	const BeamSearchStatistics& BeamSearch::GetStatistics() const
+	{
+		return statistics;
+	}
+
+	const TranspositionTable* BeamSearch::GetTranspositionTable() const
+	{
+		return transpositionTable.get();
+	}
+
+	int BeamSearch::SearchLevel(FigureKind figure, size_t rotation, bool isPieceKnown,
+		std::chrono::steady_clock::time_point deadline)
+	{
+		const int beamSize{ (int)beam.size() };
+
+		nextNode = 0;
+		std::fill(isCompleted.begin(), isCompleted.begin() + beamSize, 0);
+
+		for (std::unique_ptr<Worker>& worker : workers)
+		{
+			worker->children.clear();
+		}
+
+		auto task
+		{
+			[&](int workerIndex)
+			{
+				Worker& worker{ *workers[workerIndex] };
+
+				while (std::chrono::steady_clock::now() < deadline)
+				{
+					int i{ nextNode.fetch_add(1, std::memory_order_relaxed) };
+
+					if (i >= beamSize)
+					{
+						break;
+					}
+
+					values[i] = isPieceKnown
+						? ExpandNode(worker, beam[i], figure, rotation)
+						: ExpectNode(worker, beam[i]);
+					isCompleted[i] = 1;
+				}
+			}
+		};
+
+		pool.Run(task);
+
+		return (int)std::count(isCompleted.begin(), isCompleted.begin() + beamSize, 1);
+	}
+
+	double BeamSearch::ExpandNode(Worker& worker, const BeamNode& node, FigureKind figure, size_t rotation)
+	{
+		int count{ worker.generator.Generate(node.board, figure, rotation, SPAWN_POSITION) };
+		double best{ TOP_OUT_SCORE };
+
+		for (int i{}; i < count; i++)
+		{
+			const Placement& placement{ worker.generator.GetPlacement(i) };
+			BeamNode child{ node };
+
+			child.board.Place(figure, placement.rotation, placement.x, placement.y);
+			child.clearedLines += child.board.ClearFullRows().count;
+			child.score = EvaluateBoard(child.board, child.clearedLines, weights);
+
+			best = std::max(best, child.score);
+			worker.children.push_back(child);
+		}
+
+		worker.nodes += count;
+
+		return best;
+	}
+
+	double BeamSearch::ExpectNode(Worker& worker, const BeamNode& node)
+	{
+		uint64_t key{ GetExpectationKey(node.board, node.clearedLines) };
+		double total{};
+		Bitboard child{};
+
+		if (transpositionTable)
+		{
+			worker.transpositionProbes++;
+
+			if (transpositionTable->Probe(key, 1, total))
+			{
+				worker.transpositionHits++;
+				return total;
+			}
+		}
+
+		for (int kind{}; kind < PIECE_KINDS; kind++)
+		{
+			FigureKind figure{ (FigureKind)kind };
+			int count{ worker.generator.Generate(node.board, figure, 0, SPAWN_POSITION) };
+			double best{ TOP_OUT_SCORE };
+
+			for (int i{}; i < count; i++)
+			{
+				const Placement& placement{ worker.generator.GetPlacement(i) };
+
+				child = node.board;
+				child.Place(figure, placement.rotation, placement.x, placement.y);
+
+				int clearedLines{ node.clearedLines + child.ClearFullRows().count };
+
+				best = std::max(best, EvaluateBoard(child, clearedLines, weights));
+			}
+
+			worker.nodes += count;
+			total += best;
+		}
+
+		total /= PIECE_KINDS;
+
+		if (transpositionTable)
+		{
+			transpositionTable->Store(key, 1, total);
+		}
+
+		return total;
+	}
+
+	void BeamSearch::KeepBestNodes(std::vector<BeamNode>& nodes)
+	{
+		auto isBetter
+		{
+			[](const BeamNode& first, const BeamNode& second)
+			{
+				return first.score > second.score;
+			}
+		};
+
+		if ((int)nodes.size() > beamWidth)
+		{
+			std::nth_element(nodes.begin(), nodes.begin() + beamWidth, nodes.end(), isBetter);
+			nodes.resize(beamWidth);
+		}
+
+		std::sort(nodes.begin(), nodes.end(), isBetter);
+	}
+}
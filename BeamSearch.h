@@ -0,0 +1,102 @@
+#pragma once
+#include "Evaluation.h"
+#include "PlacementGenerator.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace GameNamespace
+{
+	const int
+		BEAM_WIDTH{ 96 },
+		BEAM_SEARCH_LEVELS{ 3 };
+
+	const double TOP_OUT_SCORE{ -1e6 };
+
+	struct BeamSearchStatistics
+	{
+		long long searches{};
+		long long nodes{};
+		double seconds{};
+		long long deadlineHits{};
+		long long completedLevels{};
+		long long expandedBeamNodes{};
+		long long transpositionProbes{};
+		long long transpositionHits{};
+
+		double GetNodesPerSecond() const;
+		double GetAverageLevels() const;
+		double GetAverageBeamSize() const;
+		double GetTranspositionHitRate() const;
+	};
+
+	// Looks for the best placement of the current piece three levels deep:
+	// the current piece, the next one, and a piece not known yet, for which
+	// every kind is tried and the best boards are averaged. Only the best
+	// BEAM_WIDTH boards of a level are expanded further.
+	//
+	// The boards of a level are handed out to the threads of a pool best
+	// first. Once the deadline passes no new board is started, and the
+	// answer comes from the boards that were finished, so Search always
+	// returns on time with the best move found so far.
+	//
+	// Different orders of placing the first two pieces often give the same
+	// board. The values of the last level are kept in a transposition table
+	// shared by the threads and keyed by the board's Zobrist hash, so such a
+	// board is only expanded once. A table size of 0 megabytes turns it off.
+	class BeamSearch
+	{
+	public:
+		explicit BeamSearch(int threads, int beamWidth = BEAM_WIDTH, EvaluationWeights weights = {},
+			size_t transpositionMegabytes = TRANSPOSITION_TABLE_MEGABYTES);
+
+		// Returns the number of levels that were searched, 0 if the piece
+		// cannot be placed at all.
+		int Search(const Engine& engine, std::chrono::steady_clock::time_point deadline, Placement& placement);
+
+		const BeamSearchStatistics& GetStatistics() const;
+		// Null when the table is turned off.
+		const TranspositionTable* GetTranspositionTable() const;
+
+	private:
+		struct BeamNode
+		{
+			Bitboard board{};
+			int firstPlacement{};
+			int clearedLines{};
+			double score{};
+		};
+
+		struct Worker
+		{
+			PlacementGenerator generator{};
+			std::vector<BeamNode> children{};
+			long long nodes{};
+			long long transpositionProbes{};
+			long long transpositionHits{};
+		};
+
+		int beamWidth{};
+		EvaluationWeights weights{};
+		ThreadPool pool;
+		std::vector<std::unique_ptr<Worker>> workers{};
+		PlacementGenerator rootGenerator{};
+		std::vector<Placement> rootPlacements{};
+		std::vector<BeamNode> beam{};
+		std::vector<BeamNode> nextBeam{};
+		std::vector<double> values{};
+		std::vector<char> isCompleted{};
+		std::atomic<int> nextNode{};
+		std::unique_ptr<TranspositionTable> transpositionTable{};
+		BeamSearchStatistics statistics{};
+
+		int SearchLevel(FigureKind figure, size_t rotation, bool isPieceKnown,
+			std::chrono::steady_clock::time_point deadline);
+		double ExpandNode(Worker& worker, const BeamNode& node, FigureKind figure, size_t rotation);
+		double ExpectNode(Worker& worker, const BeamNode& node);
+		void KeepBestNodes(std::vector<BeamNode>& nodes);
+	};
+}
@@ -0,0 +1,135 @@
+#include "Bitboard.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace GameNamespace
+{
+	namespace
+	{
+		int CountTrailingZeros(unsigned value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index{};
+
+			_BitScanForward(&index, value);
+
+			return (int)index;
+#else
+			return __builtin_ctz(value);
+#endif
+		}
+
+		// The keys of the blocks of row, which is row y of the board.
+		uint64_t HashRow(int y, BoardRow row)
+		{
+			uint64_t hash{};
+
+			for (unsigned cells{ (unsigned)(row & ~WALLS_ROW_MASK & FULL_ROW_MASK) }; cells != 0; cells &= cells - 1)
+			{
+				hash ^= ZOBRIST_KEYS.cells[y][CountTrailingZeros(cells)];
+			}
+
+			return hash;
+		}
+	}
+
+	uint64_t GetPieceHash(FigureKind figure, size_t rotation, int x, int y)
+	{
+		return ZOBRIST_KEYS.pieces[static_cast<int>(figure)][rotation]
+			^ ZOBRIST_KEYS.pieceColumns[x - MIN_PIECE_X]
+			^ ZOBRIST_KEYS.pieceRows[y];
+	}
+
+	Bitboard::Bitboard()
+	{
+		Clear();
+	}
+
+	void Bitboard::Clear()
+	{
+		for (int i{}; i < BOARD_HEIGHT_IN_BLOCKS - 1; i++)
+		{
+			rows[i] = WALLS_ROW_MASK;
+		}
+
+		for (size_t i{ BOARD_HEIGHT_IN_BLOCKS - 1 }; i < rows.size(); i++)
+		{
+			rows[i] = FULL_ROW_MASK;
+		}
+
+		hash = 0;
+	}
+
+	void Bitboard::Place(FigureKind figure, size_t rotation, int x, int y)
+	{
+		const PieceMask& mask{ PIECE_MASKS[static_cast<int>(figure)][rotation][x - MIN_PIECE_X] };
+
+		for (int i{}; i < MAX_PIECE_SIZE; i++)
+		{
+			if (y + i < BOARD_HEIGHT_IN_BLOCKS - 1)
+			{
+				hash ^= HashRow(y + i, mask.rows[i] & ~rows[y + i]);
+			}
+
+			rows[y + i] |= mask.rows[i];
+		}
+	}
+
+	bool Bitboard::IsBlock(int x, int y) const
+	{
+		return y < BOARD_HEIGHT_IN_BLOCKS - 1 && ((rows[y] & ~WALLS_ROW_MASK) >> x & 1) != 0;
+	}
+
+	BoardRow Bitboard::GetRow(int y) const
+	{
+		return rows[y];
+	}
+
+	void Bitboard::SetRow(int y, BoardRow row)
+	{
+		if (y < BOARD_HEIGHT_IN_BLOCKS - 1)
+		{
+			hash ^= HashRow(y, rows[y]) ^ HashRow(y, row);
+		}
+
+		rows[y] = row;
+	}
+
+	ClearedLines Bitboard::ClearFullRows()
+	{
+		ClearedLines clearedLines{};
+		int target{ BOARD_HEIGHT_IN_BLOCKS - 2 };
+
+		for (int i{ BOARD_HEIGHT_IN_BLOCKS - 2 }; i >= 0; i--)
+		{
+			if (rows[i] == FULL_ROW_MASK)
+			{
+				clearedLines.rows[clearedLines.count++] = i;
+				hash ^= HashRow(i, rows[i]);
+			}
+			else
+			{
+				if (target != i)
+				{
+					hash ^= HashRow(i, rows[i]) ^ HashRow(target, rows[i]);
+				}
+
+				rows[target--] = rows[i];
+			}
+		}
+
+		for (; target >= 0; target--)
+		{
+			rows[target] = WALLS_ROW_MASK;
+		}
+
+		return clearedLines;
+	}
+
+	uint64_t Bitboard::GetHash() const
+	{
+		return hash;
+	}
+}
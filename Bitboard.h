@@ -0,0 +1,153 @@
+#pragma once
+#include "EngineConstants.h"
+#include "Randomizer.h"
+#include <array>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	typedef uint16_t BoardRow;
+
+	const int
+		MIN_PIECE_X{ -1 },
+		PIECE_X_POSITIONS{ BOARD_WIDTH_IN_BLOCKS - MIN_PIECE_X },
+		BOARD_PADDING_ROWS{ MAX_PIECE_SIZE - 1 };
+
+	const BoardRow
+		WALLS_ROW_MASK{ (1 << 0) | (1 << (BOARD_WIDTH_IN_BLOCKS - 1)) },
+		FULL_ROW_MASK{ (1 << BOARD_WIDTH_IN_BLOCKS) - 1 };
+
+	struct PieceMask
+	{
+		std::array<BoardRow, MAX_PIECE_SIZE> rows{};
+	};
+
+	typedef std::array<std::array<std::array<PieceMask, PIECE_X_POSITIONS>, PIECE_ROTATIONS>, PIECE_KINDS>
+		PieceMaskTable;
+
+	constexpr PieceMaskTable BuildPieceMasks()
+	{
+		PieceMaskTable table{};
+
+		for (int kind{}; kind < PIECE_KINDS; kind++)
+		{
+			for (int rotation{}; rotation < PIECE_ROTATIONS; rotation++)
+			{
+				const PieceLayout& layout{ PIECE_LAYOUTS[kind][rotation] };
+
+				for (int x{ MIN_PIECE_X }; x < BOARD_WIDTH_IN_BLOCKS; x++)
+				{
+					PieceMask& mask{ table[kind][rotation][x - MIN_PIECE_X] };
+
+					for (int i{}; i < MAX_PIECE_SIZE; i++)
+					{
+						// A cell left of the board can only collide, so it
+						// is folded onto the left wall.
+						mask.rows[i] = x < 0
+							? (BoardRow)((layout.rowMasks[i] >> -x) | (layout.rowMasks[i] & 1))
+							: (BoardRow)(layout.rowMasks[i] << x);
+					}
+				}
+			}
+		}
+
+		return table;
+	}
+
+	constexpr PieceMaskTable PIECE_MASKS{ BuildPieceMasks() };
+
+	// Random keys for Zobrist hashing: one per cell inside the walls, and one
+	// per piece kind and rotation, column and row for the falling piece.
+	struct ZobristKeys
+	{
+		std::array<std::array<uint64_t, BOARD_WIDTH_IN_BLOCKS>, BOARD_HEIGHT_IN_BLOCKS - 1> cells{};
+		std::array<std::array<uint64_t, PIECE_ROTATIONS>, PIECE_KINDS> pieces{};
+		std::array<uint64_t, PIECE_X_POSITIONS> pieceColumns{};
+		std::array<uint64_t, BOARD_HEIGHT_IN_BLOCKS> pieceRows{};
+	};
+
+	constexpr ZobristKeys BuildZobristKeys()
+	{
+		ZobristKeys keys{};
+		uint64_t state{ 0x5A0B1257ull };
+
+		for (auto& row : keys.cells)
+		{
+			for (uint64_t& key : row)
+			{
+				key = SplitMix64(state);
+			}
+		}
+
+		for (auto& rotations : keys.pieces)
+		{
+			for (uint64_t& key : rotations)
+			{
+				key = SplitMix64(state);
+			}
+		}
+
+		for (uint64_t& key : keys.pieceColumns)
+		{
+			key = SplitMix64(state);
+		}
+
+		for (uint64_t& key : keys.pieceRows)
+		{
+			key = SplitMix64(state);
+		}
+
+		return keys;
+	}
+
+	constexpr ZobristKeys ZOBRIST_KEYS{ BuildZobristKeys() };
+
+	uint64_t GetPieceHash(FigureKind figure, size_t rotation, int x, int y);
+
+	// Rows removed by a line clear, as indices into the board before the
+	// clear, bottom row first.
+	struct ClearedLines
+	{
+		int count{};
+		std::array<int, BOARD_HEIGHT_IN_BLOCKS - 1> rows{};
+	};
+
+	// Every row is a bit set of occupied cells, bit N being column N. Walls and
+	// the floor are stored as set bits, so a piece only has to be tested
+	// against the board itself. Rows below the floor are padding: a piece mask
+	// is always MAX_PIECE_SIZE rows tall and may hang past the last row.
+	//
+	// The Zobrist hash of the blocks inside the walls is kept up to date by
+	// every change: Place adds the keys of the piece's cells and a line clear
+	// only rehashes the rows it moves.
+	class Bitboard
+	{
+	public:
+		Bitboard();
+
+		void Clear();
+		bool IsCollision(FigureKind figure, size_t rotation, int x, int y) const;
+		void Place(FigureKind figure, size_t rotation, int x, int y);
+		bool IsBlock(int x, int y) const;
+		BoardRow GetRow(int y) const;
+		void SetRow(int y, BoardRow row);
+		ClearedLines ClearFullRows();
+		uint64_t GetHash() const;
+
+	private:
+		std::array<BoardRow, BOARD_HEIGHT_IN_BLOCKS + BOARD_PADDING_ROWS> rows{};
+		uint64_t hash{};
+	};
+
+	// Defined here so that the move searches inline it: the whole test is four
+	// ANDs against a precomputed mask.
+	inline bool Bitboard::IsCollision(FigureKind figure, size_t rotation, int x, int y) const
+	{
+		const PieceMask& mask{ PIECE_MASKS[static_cast<int>(figure)][rotation][x - MIN_PIECE_X] };
+
+		return ((rows[y] & mask.rows[0])
+			| (rows[y + 1] & mask.rows[1])
+			| (rows[y + 2] & mask.rows[2])
+			| (rows[y + 3] & mask.rows[3])) != 0;
+	}
+}
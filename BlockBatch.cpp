@@ -0,0 +1,132 @@
+#include "BlockBatch.h"
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const int
+			QUAD_VERTICES{ 4 },
+			QUAD_INDICES{ 6 };
+
+		const int QUAD_INDEX_PATTERN[QUAD_INDICES]{ 0, 1, 2, 2, 1, 3 };
+	}
+
+	BlockBatch::BlockBatch(SDL_Renderer* renderer, SDL_Texture* texture, int blockSize, int capacity)
+		: renderer{ renderer }, texture{ texture }, blockSize{ blockSize }
+	{
+		vertices.reserve((size_t)capacity * QUAD_VERTICES);
+		indices.reserve((size_t)capacity * QUAD_INDICES);
+	}
+
+	void BlockBatch::Add(int x, int y, Uint8 alpha)
+	{
+		int first{ (int)vertices.size() };
+		float left{ (float)x }, top{ (float)y };
+		float right{ (float)(x + blockSize) }, bottom{ (float)(y + blockSize) };
+		SDL_Color color{ 255, 255, 255, alpha };
+
+		vertices.push_back({ { left, top }, color, { 0, 0 } });
+		vertices.push_back({ { right, top }, color, { 1, 0 } });
+		vertices.push_back({ { left, bottom }, color, { 0, 1 } });
+		vertices.push_back({ { right, bottom }, color, { 1, 1 } });
+
+		for (int index : QUAD_INDEX_PATTERN)
+		{
+			indices.push_back(first + index);
+		}
+	}
+
+	void BlockBatch::Flush()
+	{
+		if (vertices.empty())
+		{
+			return;
+		}
+
+		if (isGeometrySupported
+			&& SDL_RenderGeometry(renderer, texture, vertices.data(), (int)vertices.size(),
+				indices.data(), (int)indices.size()) == 0)
+		{
+			drawCalls++;
+		}
+		else
+		{
+			isGeometrySupported = false;
+			CopyBlocks();
+		}
+
+		frameVertices += (int)vertices.size();
+		vertices.clear();
+		indices.clear();
+	}
+
+	void BlockBatch::EndFrame()
+	{
+		Flush();
+
+		lastDrawCalls = drawCalls;
+		lastFrameVertices = frameVertices;
+		mostFrameVertices = frameVertices > mostFrameVertices ? frameVertices : mostFrameVertices;
+		totalDrawCalls += drawCalls;
+		totalVertices += frameVertices;
+		frames++;
+
+		drawCalls = 0;
+		frameVertices = 0;
+	}
+
+	int BlockBatch::GetFrameDrawCalls() const
+	{
+		return lastDrawCalls;
+	}
+
+	int BlockBatch::GetFrameVertices() const
+	{
+		return lastFrameVertices;
+	}
+
+	long long BlockBatch::GetFrames() const
+	{
+		return frames;
+	}
+
+	long long BlockBatch::GetDrawCalls() const
+	{
+		return totalDrawCalls;
+	}
+
+	long long BlockBatch::GetVertices() const
+	{
+		return totalVertices;
+	}
+
+	int BlockBatch::GetMostFrameVertices() const
+	{
+		return mostFrameVertices;
+	}
+
+	bool BlockBatch::IsGeometrySupported() const
+	{
+		return isGeometrySupported;
+	}
+
+	void BlockBatch::CopyBlocks()
+	{
+		for (size_t i{}; i < vertices.size(); i += QUAD_VERTICES)
+		{
+			SDL_Rect rect
+			{
+				(int)vertices[i].position.x,
+				(int)vertices[i].position.y,
+				blockSize,
+				blockSize
+			};
+
+			SDL_SetTextureAlphaMod(texture, vertices[i].color.a);
+			SDL_RenderCopy(renderer, texture, NULL, &rect);
+			drawCalls++;
+		}
+
+		SDL_SetTextureAlphaMod(texture, SDL_ALPHA_OPAQUE);
+	}
+}
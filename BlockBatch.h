@@ -0,0 +1,57 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+namespace GameNamespace
+{
+	// Collects the block quads of a frame and draws them with one
+	// SDL_RenderGeometry call against the block texture, instead of one
+	// SDL_RenderCopy per block. A quad's alpha goes into its vertex colours,
+	// so translucent blocks share the call. Renderers that cannot draw
+	// geometry fall back to copying the blocks one by one.
+	//
+	// Flush submits what has been added, which has to happen before anything
+	// that must appear above the blocks, and before the render target
+	// changes. EndFrame closes the counters of a frame.
+	class BlockBatch
+	{
+	public:
+		BlockBatch(SDL_Renderer* renderer, SDL_Texture* texture, int blockSize, int capacity);
+
+		BlockBatch(const BlockBatch&) = delete;
+		BlockBatch& operator=(const BlockBatch&) = delete;
+
+		void Add(int x, int y, Uint8 alpha = SDL_ALPHA_OPAQUE);
+		void Flush();
+		void EndFrame();
+
+		// Counters of the last finished frame.
+		int GetFrameDrawCalls() const;
+		int GetFrameVertices() const;
+
+		long long GetFrames() const;
+		long long GetDrawCalls() const;
+		long long GetVertices() const;
+		int GetMostFrameVertices() const;
+		bool IsGeometrySupported() const;
+
+	private:
+		SDL_Renderer* renderer{};
+		SDL_Texture* texture{};
+		int blockSize{};
+		std::vector<SDL_Vertex> vertices{};
+		std::vector<int> indices{};
+		bool isGeometrySupported{ true };
+
+		int drawCalls{};
+		int frameVertices{};
+		int lastDrawCalls{};
+		int lastFrameVertices{};
+		int mostFrameVertices{};
+		long long frames{};
+		long long totalDrawCalls{};
+		long long totalVertices{};
+
+		void CopyBlocks();
+	};
+}
@@ -0,0 +1,165 @@
+#include "BoardProfile.h"
+#include <algorithm>
+
+namespace GameNamespace
+{
+	BoardProfile::BoardProfile()
+	{
+		Reset(Bitboard{});
+	}
+
+	void BoardProfile::Reset(const Bitboard& board)
+	{
+		heights.fill(0);
+		columnBlocks.fill(0);
+		rowBlocks.fill(0);
+		fullRows = 0;
+		holes = 0;
+
+		heights[0] = heights[BOARD_WIDTH_IN_BLOCKS - 1] = BOARD_FLOOR_ROW;
+		columnBlocks[0] = columnBlocks[BOARD_WIDTH_IN_BLOCKS - 1] = BOARD_FLOOR_ROW;
+
+		for (int y{}; y < BOARD_FLOOR_ROW; y++)
+		{
+			for (int x{ 1 }; x <= BOARD_INTERIOR_COLUMNS; x++)
+			{
+				if (board.IsBlock(x, y))
+				{
+					heights[x] = std::max(heights[x], BOARD_FLOOR_ROW - y);
+					columnBlocks[x]++;
+					rowBlocks[y]++;
+				}
+			}
+
+			if (rowBlocks[y] == BOARD_INTERIOR_COLUMNS)
+			{
+				fullRows |= 1u << y;
+			}
+		}
+
+		for (int x{ 1 }; x <= BOARD_INTERIOR_COLUMNS; x++)
+		{
+			holes += heights[x] - columnBlocks[x];
+		}
+	}
+
+	void BoardProfile::Place(FigureKind figure, size_t rotation, int x, int y)
+	{
+		int heightGain{};
+
+		for (const CellOffset& cell : PIECE_LAYOUTS[static_cast<int>(figure)][rotation].cells)
+		{
+			int column{ x + cell.x };
+			int row{ y + cell.y };
+			int height{ BOARD_FLOOR_ROW - row };
+
+			columnBlocks[column]++;
+
+			if (++rowBlocks[row] == BOARD_INTERIOR_COLUMNS)
+			{
+				fullRows |= 1u << row;
+			}
+
+			if (height > heights[column])
+			{
+				heightGain += height - heights[column];
+				heights[column] = height;
+			}
+		}
+
+		// Every new cell above the old top leaves the cells under it empty;
+		// every cell below it fills a hole.
+		holes += heightGain - PIECE_CELLS;
+	}
+
+	void BoardProfile::ClearRows(const Bitboard& board, const ClearedLines& clearedLines)
+	{
+		uint32_t clearedRows{};
+		int target{ BOARD_FLOOR_ROW - 1 };
+
+		for (int i{}; i < clearedLines.count; i++)
+		{
+			clearedRows |= 1u << clearedLines.rows[i];
+		}
+
+		for (int y{ BOARD_FLOOR_ROW - 1 }; y >= 0; y--)
+		{
+			if ((clearedRows >> y & 1) == 0)
+			{
+				rowBlocks[target--] = rowBlocks[y];
+			}
+		}
+
+		for (; target >= 0; target--)
+		{
+			rowBlocks[target] = 0;
+		}
+
+		fullRows = 0;
+		holes = 0;
+
+		for (int x{ 1 }; x <= BOARD_INTERIOR_COLUMNS; x++)
+		{
+			int top{ BOARD_FLOOR_ROW - heights[x] };
+
+			columnBlocks[x] -= clearedLines.count;
+			heights[x] -= clearedLines.count;
+
+			// The cleared rows are full, so they are all below the top of
+			// every column. If the top itself went, the new top may be lower.
+			if ((clearedRows >> top & 1) != 0)
+			{
+				while (heights[x] > 0 && !board.IsBlock(x, BOARD_FLOOR_ROW - heights[x]))
+				{
+					heights[x]--;
+				}
+			}
+
+			holes += heights[x] - columnBlocks[x];
+		}
+	}
+
+	int BoardProfile::GetHeight(int x) const
+	{
+		return heights[x];
+	}
+
+	int BoardProfile::GetColumnBlocks(int x) const
+	{
+		return columnBlocks[x];
+	}
+
+	int BoardProfile::GetHoles() const
+	{
+		return holes;
+	}
+
+	int BoardProfile::GetRowBlocks(int y) const
+	{
+		return rowBlocks[y];
+	}
+
+	bool BoardProfile::HasFullRows() const
+	{
+		return fullRows != 0;
+	}
+
+	int BoardProfile::GetLandingRow(FigureKind figure, size_t rotation, int x) const
+	{
+		int row{ BOARD_FLOOR_ROW };
+
+		// The upper cells of a column never give the lowest row, so taking
+		// all cells is the same as taking the piece's bottom profile.
+		for (const CellOffset& cell : PIECE_LAYOUTS[static_cast<int>(figure)][rotation].cells)
+		{
+			row = std::min(row, BOARD_FLOOR_ROW - heights[x + cell.x] - 1 - cell.y);
+		}
+
+		return row;
+	}
+
+	const std::array<int, BOARD_WIDTH_IN_BLOCKS>& BoardProfile::GetHeights() const
+	{
+		return heights;
+	}
+}
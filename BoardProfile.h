@@ -0,0 +1,48 @@
+#pragma once
+#include "Bitboard.h"
+#include <array>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	const int
+		BOARD_FLOOR_ROW{ BOARD_HEIGHT_IN_BLOCKS - 1 },
+		BOARD_INTERIOR_COLUMNS{ BOARD_WIDTH_IN_BLOCKS - 2 };
+
+	// The shape of a board's stack: the height of every column counted from
+	// the floor, the blocks in every column and row, and the holes, empty
+	// cells with a block above them. The walls count as full columns.
+	//
+	// Reset builds it from a board. After that Place costs as much as the
+	// piece has cells and ClearRows as much as the cleared rows, apart from
+	// columns whose top block was cleared, which are searched down for their
+	// new top. Full rows are known without looking at the board.
+	class BoardProfile
+	{
+	public:
+		BoardProfile();
+
+		void Reset(const Bitboard& board);
+		void Place(FigureKind figure, size_t rotation, int x, int y);
+		// board is the board after the clear.
+		void ClearRows(const Bitboard& board, const ClearedLines& clearedLines);
+
+		int GetHeight(int x) const;
+		int GetColumnBlocks(int x) const;
+		int GetHoles() const;
+		int GetRowBlocks(int y) const;
+		bool HasFullRows() const;
+		// The row a piece at column x comes to rest in when dropped onto the
+		// surface: every cell must stay above its column's top. Only right
+		// when no cell of the piece is below the top of its column yet.
+		int GetLandingRow(FigureKind figure, size_t rotation, int x) const;
+		const std::array<int, BOARD_WIDTH_IN_BLOCKS>& GetHeights() const;
+
+	private:
+		std::array<int, BOARD_WIDTH_IN_BLOCKS> heights{};
+		std::array<int, BOARD_WIDTH_IN_BLOCKS> columnBlocks{};
+		std::array<int, BOARD_FLOOR_ROW> rowBlocks{};
+		uint32_t fullRows{};
+		int holes{};
+	};
+}
@@ -0,0 +1,189 @@
+#include "Bot.h"
+#include <algorithm>
+#include <limits>
+
+namespace GameNamespace
+{
+	bool PlacementChooser::Choose(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position,
+		const SpawnedPiece* next, const EvaluationWeights& weights, std::chrono::steady_clock::time_point deadline,
+		Placement& placement)
+	{
+		Bitboard child{};
+
+		isOverBudget = false;
+
+		int count{ currentGenerator.Generate(board, figure, rotation, position) };
+
+		if (count == 0)
+		{
+			return false;
+		}
+
+		for (int i{}; i < count; i++)
+		{
+			const Placement& candidate{ currentGenerator.GetPlacement(i) };
+
+			child = board;
+			child.Place(figure, candidate.rotation, candidate.x, candidate.y);
+
+			boardScores[i] = EvaluateBoard(child, child.ClearFullRows().count, weights);
+			order[i] = i;
+		}
+
+		if (next == nullptr)
+		{
+			placement = currentGenerator.GetPlacement(
+				(int)(std::max_element(boardScores.begin(), boardScores.begin() + count) - boardScores.begin()));
+
+			return true;
+		}
+
+		std::sort(order.begin(), order.begin() + count,
+			[this](int first, int second)
+			{
+				return boardScores[first] > boardScores[second];
+			});
+
+		int best{ order[0] };
+		double bestScore{ std::numeric_limits<double>::lowest() };
+
+		for (int i{}; i < count; i++)
+		{
+			if (std::chrono::steady_clock::now() >= deadline)
+			{
+				isOverBudget = true;
+				break;
+			}
+
+			const Placement& candidate{ currentGenerator.GetPlacement(order[i]) };
+
+			child = board;
+			child.Place(figure, candidate.rotation, candidate.x, candidate.y);
+
+			double score{ EvaluateNextPiece(child, *next, child.ClearFullRows().count, weights) };
+
+			if (score > bestScore)
+			{
+				best = order[i];
+				bestScore = score;
+			}
+		}
+
+		placement = currentGenerator.GetPlacement(best);
+
+		return true;
+	}
+
+	bool PlacementChooser::IsOverBudget() const
+	{
+		return isOverBudget;
+	}
+
+	double PlacementChooser::EvaluateNextPiece(const Bitboard& board, SpawnedPiece next, int clearedLines,
+		const EvaluationWeights& weights)
+	{
+		int count{ nextGenerator.Generate(board, next.figure, next.rotation,
+			{ PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW }) };
+		double bestScore{ std::numeric_limits<double>::lowest() };
+		Bitboard child{};
+
+		for (int i{}; i < count; i++)
+		{
+			const Placement& placement{ nextGenerator.GetPlacement(i) };
+
+			child = board;
+			child.Place(next.figure, placement.rotation, placement.x, placement.y);
+
+			int nextClearedLines{ child.ClearFullRows().count };
+
+			bestScore = std::max(bestScore, EvaluateBoard(child, clearedLines + nextClearedLines, weights));
+		}
+
+		return bestScore;
+	}
+
+	Bot::Bot(EvaluationWeights weights, std::chrono::microseconds budget, int searchThreads,
+		size_t transpositionMegabytes)
+		: weights{ weights }, budget{ budget }
+	{
+		if (searchThreads > 0)
+		{
+			beamSearch = std::make_unique<BeamSearch>(searchThreads, BEAM_WIDTH, weights, transpositionMegabytes);
+		}
+	}
+
+	PieceMovement Bot::GetNextMovement(const Engine& engine)
+	{
+		if (engine.GetBoardVersion() != plannedBoardVersion)
+		{
+			Plan(engine);
+		}
+
+		if (pathIndex < pathLength)
+		{
+			return path[pathIndex++];
+		}
+
+		// The piece is resting on the stack; a hard drop locks it at once.
+		return PieceMovement::HardDrop;
+	}
+
+	long long Bot::GetPlannedPieces() const
+	{
+		return plannedPieces;
+	}
+
+	long long Bot::GetOverBudgetPieces() const
+	{
+		return overBudgetPieces;
+	}
+
+	std::chrono::microseconds Bot::GetLongestPlan() const
+	{
+		return longestPlan;
+	}
+
+	const BeamSearch* Bot::GetBeamSearch() const
+	{
+		return beamSearch.get();
+	}
+
+	void Bot::Plan(const Engine& engine)
+	{
+		auto start{ std::chrono::steady_clock::now() };
+		auto deadline{ start + budget };
+		Placement placement{};
+
+		plannedBoardVersion = engine.GetBoardVersion();
+		plannedPieces++;
+		pathLength = 0;
+		pathIndex = 0;
+
+		bool isPlaced{};
+
+		if (beamSearch)
+		{
+			long long deadlineHits{ beamSearch->GetStatistics().deadlineHits };
+
+			isPlaced = beamSearch->Search(engine, deadline, placement) > 0;
+			overBudgetPieces += beamSearch->GetStatistics().deadlineHits != deadlineHits ? 1 : 0;
+		}
+		else
+		{
+			SpawnedPiece next{ engine.GetNextFigure(), (int)engine.GetNextRotation() };
+
+			isPlaced = chooser.Choose(engine.GetBoard(), engine.GetCurrentFigure(), engine.GetRotation(),
+				engine.GetPosition(), &next, weights, deadline, placement);
+			overBudgetPieces += chooser.IsOverBudget() ? 1 : 0;
+		}
+
+		if (isPlaced)
+		{
+			pathLength = std::max(0, currentGenerator.FindPath(engine.GetBoard(), engine.GetCurrentFigure(),
+				engine.GetRotation(), engine.GetPosition(), placement, path.data(), (int)path.size()));
+		}
+
+		longestPlan = std::max(longestPlan,
+			std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "BeamSearch.h"
+#include "Evaluation.h"
+#include "PlacementGenerator.h"
+#include <array>
+#include <chrono>
+#include <memory>
+
+namespace GameNamespace
+{
+	const int BOT_THINKING_BUDGET_MICROSECONDS{ 2000 };
+
+	// Chooses where a piece goes. Every placement is scored by its own board
+	// and, when the next piece is given, by the best board the next piece
+	// can make after it. The lookahead goes through the placements in the
+	// order of their own board's score and stops at the deadline, keeping
+	// the best placement found so far. Bot plays with it and Tuner tunes
+	// the weights with it, so both make the same choice.
+	class PlacementChooser
+	{
+	public:
+		// Returns false if the piece cannot be placed at all.
+		bool Choose(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position,
+			const SpawnedPiece* next, const EvaluationWeights& weights, std::chrono::steady_clock::time_point deadline,
+			Placement& placement);
+		// Whether the last Choose ran out of time.
+		bool IsOverBudget() const;
+
+	private:
+		PlacementGenerator currentGenerator{};
+		PlacementGenerator nextGenerator{};
+		std::array<double, MAX_PLACEMENTS> boardScores{};
+		std::array<int, MAX_PLACEMENTS> order{};
+		bool isOverBudget{};
+
+		double EvaluateNextPiece(const Bitboard& board, SpawnedPiece next, int clearedLines,
+			const EvaluationWeights& weights);
+	};
+
+	// Plays the game by choosing where every piece should go and then
+	// returning one movement per tick to take it there. A placement is scored
+	// by the best board the next piece can make after it. Placements are
+	// looked ahead from in the order of their own board's score and the
+	// lookahead stops when the time budget runs out, so a slow machine plays
+	// worse rather than later.
+	//
+	// With searchThreads set the placement is chosen by a BeamSearch on that
+	// many threads instead, under the same budget, with a transposition
+	// table of transpositionMegabytes.
+	class Bot
+	{
+	public:
+		Bot(EvaluationWeights weights = {},
+			std::chrono::microseconds budget = std::chrono::microseconds{ BOT_THINKING_BUDGET_MICROSECONDS },
+			int searchThreads = 0,
+			size_t transpositionMegabytes = TRANSPOSITION_TABLE_MEGABYTES);
+
+		PieceMovement GetNextMovement(const Engine& engine);
+
+		long long GetPlannedPieces() const;
+		long long GetOverBudgetPieces() const;
+		std::chrono::microseconds GetLongestPlan() const;
+		const BeamSearch* GetBeamSearch() const;
+
+	private:
+		EvaluationWeights weights{};
+		std::chrono::microseconds budget{};
+		PlacementGenerator currentGenerator{};
+		PlacementChooser chooser{};
+		std::array<PieceMovement, MAX_PLACEMENT_PATH> path{};
+		int pathLength{};
+		int pathIndex{};
+		long long plannedBoardVersion{ -1 };
+		long long plannedPieces{};
+		long long overBudgetPieces{};
+		std::chrono::microseconds longestPlan{};
+		std::unique_ptr<BeamSearch> beamSearch{};
+
+		void Plan(const Engine& engine);
+	};
+}
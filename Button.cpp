@@ -9,9 +9,11 @@ namespace GameNamespace
 		SDL_Renderer* renderer,
 		const char* text,
 		TTF_Font* font,
-		SDL_Color color)
+		SDL_Color color,
+		OpenGLRenderer* openGL)
 	{
 		this->position = position;
+		this->openGL = openGL;
 		this->height = height;
 		this->width = width;
 
@@ -29,6 +31,13 @@ namespace GameNamespace
 			throw SurfaceNullReference();
 		}
 
+		if (openGL != nullptr)
+		{
+			openGLMessage = openGL->AddTexture(surface);
+			SDL_FreeSurface(surface);
+			return;
+		}
+
 		message = SDL_CreateTextureFromSurface(renderer, surface);
 
 		if (message == NULL)
@@ -47,6 +56,12 @@ namespace GameNamespace
 
 	void Button::RenderButton(SDL_Renderer* renderer)
 	{
+		if (openGL != nullptr)
+		{
+			openGL->Draw(openGLMessage, NULL, &buttonRect, { 255, 255, 255, SDL_ALPHA_OPAQUE });
+			return;
+		}
+
 		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
 		SDL_RenderFillRect(renderer, &buttonRect);
 		SDL_RenderCopy(renderer, message, NULL, &buttonRect);
@@ -4,6 +4,7 @@
 #include <Windows.h>
 #include "Constants.h"
 #include "GameExceptions.h"
+#include "OpenGLRenderer.h"
 
 namespace GameNamespace
 {
@@ -17,7 +18,8 @@ namespace GameNamespace
 			SDL_Renderer* renderer,
 			const char* text,
 			TTF_Font* font,
-			SDL_Color color);
+			SDL_Color color,
+			OpenGLRenderer* openGL = nullptr);
 
 		~Button();
 		void RenderButton(SDL_Renderer* renderer);
@@ -30,6 +32,8 @@ namespace GameNamespace
 		SDL_Rect buttonRect{};
 
 		SDL_Texture* message{};
+		OpenGLRenderer* openGL{};
+		size_t openGLMessage{};
 
 		void (*function)();
 	};
@@ -1,21 +1,17 @@
 #pragma once
+#include <Windows.h>
 #include <SDL_ttf.h>
 #include <vector>
+#include "EngineConstants.h"
 
 namespace GameNamespace
 {
-    typedef std::vector<std::vector<std::vector<std::vector<int>>>> FigureContainer;
-    typedef std::vector<std::vector<int>> Figure;
-
     const int
         WINDOW_WIDTH{ 1920 },
         WINDOW_HEIGHT{ 1080 },
 
         BLOCK_SIZE{ WINDOW_WIDTH / 48 },
 
-        BOARD_WIDTH_IN_BLOCKS{ 11 },
-        BOARD_HEIGHT_IN_BLOCKS{ 23 },
-
         BOARD_WIDTH{ BOARD_WIDTH_IN_BLOCKS * BLOCK_SIZE },
         BOARD_HEIGHT{ BOARD_HEIGHT_IN_BLOCKS * BLOCK_SIZE },
 
@@ -23,11 +19,9 @@ namespace GameNamespace
         BOARD_POSITION_Y{ (WINDOW_HEIGHT - BOARD_HEIGHT) / 2 },
 
         TIME_DELAY{ 5 },
-        PIECE_KINDS{ 7 },
-        PIECE_ROTATIONS{ 4 },
-        PIECE_INITIAL_SHIFT_X{ BLOCK_SIZE * 4 },
-        FPS{ 60 },
-        FRAME_DELAY{ 400 / FPS },
+        LOGIC_TICKS_PER_SECOND{ 150 },
+        MAX_TICKS_PER_FRAME{ 30 },
+        DEFAULT_REFRESH_RATE{ 60 },
 
         SCORE_DIGIT_HEIGHT{ BLOCK_SIZE },
         SCORE_DIGIT_WIDTH{ BLOCK_SIZE },
@@ -61,12 +55,32 @@ namespace GameNamespace
             START_AGAIN_MESSAGE_HEIGHT + GAME_OVER_MESSAGE_HEIGHT + 2 * BLOCK_SIZE
         },
 
-        SCORE_ADDITION{ 9 },
-        SCORE_MAX_VALUE{ 99999 },
         MAIN_FONT_SIZE{ 24 },
         SCENE_FONT_SIZE{ 24 },
         BUTTON_HEIGHT{ 140 },
-        BUTTON_WIDTH{ 240 };
+        BUTTON_WIDTH{ 240 },
+        BUTTONS_GAP{ BLOCK_SIZE },
+
+        BOT_RESTART_DELAY_TICKS{ 3 * LOGIC_TICKS_PER_SECOND },
+
+        // Every cell of the board plus the ghost, the falling and the next
+        // piece: the most blocks one frame draws.
+        BLOCK_BATCH_CAPACITY{ BOARD_WIDTH_IN_BLOCKS * BOARD_HEIGHT_IN_BLOCKS + 3 * 4 },
+
+        PACING_OVERLAY_X{ BLOCK_SIZE / 2 },
+        PACING_OVERLAY_Y{ BLOCK_SIZE / 2 },
+        PACING_BAR_WIDTH{ BLOCK_SIZE / 4 },
+        PACING_BAR_HEIGHT{ 4 * BLOCK_SIZE },
+        PACING_TEXT_HEIGHT{ BLOCK_SIZE / 2 },
+        PACING_CHARACTER_WIDTH{ BLOCK_SIZE / 4 },
+
+        // How long the menu, pause and game over screens sleep at most
+        // between checks when nothing happens.
+        IDLE_WAIT_MILLISECONDS{ 250 };
+
+    const Uint8
+        GHOST_PIECE_ALPHA{ 80 },
+        BOARD_TEXTURE_ALPHA{ 100 };
 
     const char* const GAME_WINDOW_NAME{ "Tetris" };
     
@@ -77,9 +91,16 @@ namespace GameNamespace
     const char* const BOARD_TEXTURE_FILE_PATH{ "./Textures/board_texture.png" };
     const char* const INFO_BLOCK_TEXTURE_FILE_PATH{ "./Textures/info_block_texture.png" };
 
+    const char* const REPLAY_DIRECTORY_PATH{ "./Replays" };
+    const char* const REPLAY_FILE_EXTENSION{ ".replay" };
+
     const SDL_Color
         BUTTON_FONT_COLOR{ 255, 0, 0 },
-        MAIN_FONT_COLOR{ 255, 0, 0 };
+        MAIN_FONT_COLOR{ 255, 0, 0 },
+        OVERLAY_COLOR{ 0, 0, 0, 150 },
+        PACING_TEXT_COLOR{ 255, 255, 255, 255 },
+        PACING_ON_TIME_COLOR{ 0, 255, 0, 255 },
+        PACING_LATE_COLOR{ 255, 0, 0, 255 };
 
     const SDL_Rect GAME_OVER_MESSAGE_RECTANGLE
     {
@@ -121,12 +142,26 @@ namespace GameNamespace
         BOARD_HEIGHT - 3 * BLOCK_SIZE
     };
 
+    const SDL_Rect BOARD_CACHE_RECT
+    {
+        BOARD_POSITION_X,
+        BOARD_POSITION_Y,
+        BOARD_WIDTH,
+        BOARD_HEIGHT
+    };
+
     const POINT MENU_BUTTON_POINT
     {
         (WINDOW_WIDTH - BUTTON_WIDTH) / 2,
         (WINDOW_HEIGHT - BUTTON_HEIGHT) / 2
     };
 
+    const POINT BOT_BUTTON_POINT
+    {
+        MENU_BUTTON_POINT.x,
+        MENU_BUTTON_POINT.y + BUTTON_HEIGHT + BUTTONS_GAP
+    };
+
     const std::vector<SDL_Rect> SCORE_MESSAGE_RECTANGLES
     {
         {
@@ -170,175 +205,12 @@ namespace GameNamespace
         white
     };
 
-    enum class FigureKind
-    {
-        Square = 0,
-        I = 1,
-        L = 2,
-        J = 3,
-        N = 4,
-        N_mirrored = 5,
-        T = 6
-    };
-
-    const FigureContainer Figures
-    {
-        {
-            {
-                {1, 1},
-                {1, 1}
-            },
-            {
-                {1, 1},
-                {1, 1}
-            },
-            {
-                {1, 1},
-                {1, 1}
-            },
-            {
-                {1, 1},
-                {1, 1}
-            }
-        },
-        {
-            {
-                {0, 1, 0},
-                {0, 1, 0},
-                {0, 1, 0},
-                {0, 1, 0}
-            },
-            {
-                {0, 0, 0, 0},
-                {1, 1, 1, 1},
-                {0, 0, 0, 0}
-            },
-            {
-                {0, 1, 0},
-                {0, 1, 0},
-                {0, 1, 0},
-                {0, 1, 0}
-            },
-            {
-                {0, 0, 0, 0},
-                {1, 1, 1, 1},
-                {0, 0, 0, 0}
-            }
-        },
-        {
-            {
-                {1, 0},
-                {1, 0},
-                {1, 1}
-            },
-            {
-                {1, 1, 1},
-                {1, 0, 0}
-            },
-            {
-                {1, 1},
-                {0, 1},
-                {0, 1},
-            },
-            {
-                {0, 0, 1},
-                {1, 1, 1}
-            }
-        },
-        {
-            {
-                {0, 1},
-                {0, 1},
-                {1, 1}
-            },
-            {
-                {1, 0, 0},
-                {1, 1, 1}
-            },
-            {
-                {1, 1},
-                {1, 0},
-                {1, 0},
-            },
-            {
-                {1, 1, 1},
-                {0, 0, 1}
-            }
-        },
-        {
-            {
-                {1, 1, 0},
-                {0, 1, 1}
-            },
-            {
-                {0, 1},
-                {1, 1},
-                {1, 0}
-            },
-            {
-                {1, 1, 0},
-                {0, 1, 1}
-            },
-            {
-                {0, 1},
-                {1, 1},
-                {1, 0}
-            },
-        },
-        {
-            {
-                {0, 1, 1},
-                {1, 1, 0}
-            },
-            {
-                {1, 0},
-                {1, 1},
-                {0, 1}
-            },
-            {
-                {0, 1, 1},
-                {1, 1, 0}
-            },
-            {
-                {1, 0},
-                {1, 1},
-                {0, 1}
-            },
-        },
-        {
-            {
-                {0, 1, 0},
-                {1, 1, 1}
-            },
-            {
-                {1, 0},
-                {1, 1},
-                {1, 0}
-            },
-            {
-                {1, 1, 1},
-                {0, 1, 0}
-            },
-            {
-                {0, 1},
-                {1, 1},
-                {0, 1}
-            }
-        }
-    };
-
     enum class Font
     {
         GameOver,
         Scene
     };
 
-    enum class Direction
-    {
-        Left = -1,
-        Right = 1
-    };
-
     enum class GameState
     {
         MenuMode,
@@ -348,20 +220,10 @@ namespace GameNamespace
         GameOver
     };
 
-    enum class PieceMovement
-    {
-        None,
-        Left,
-        Right,
-        Rotation,
-        SpeedUp,
-    };
-
-    struct PieceRotation 
+    enum class RenderBackend
     {
-        int pieceShift{};
-        bool pieceCanRotate{};
-        int nextRotation{};
+        SDLRenderer,
+        OpenGL
     };
 
     const Color BACKGROUND_COLOR{ Color::black };
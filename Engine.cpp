@@ -0,0 +1,413 @@
+#include "Engine.h"
+
+namespace GameNamespace
+{
+	namespace
+	{
+		int CalculateGhostRow(const Bitboard& board, const BoardProfile& profile, FigureKind figure, size_t rotation,
+			PiecePosition position)
+		{
+			int row{ profile.GetLandingRow(figure, rotation, position.x) };
+
+			// Above the row the piece is in means it has been slid under an
+			// overhang, where the surface says nothing; it falls step by step.
+			if (row < position.y)
+			{
+				row = position.y;
+
+				while (!board.IsCollision(figure, rotation, position.x, row + 1))
+				{
+					row++;
+				}
+			}
+
+			return row;
+		}
+
+		void SpawnNextPiece(const EngineFields& fields)
+		{
+			SpawnedPiece piece{ fields.randomizer.Next() };
+
+			fields.currentFigure = fields.nextFigure;
+			fields.rotation = fields.nextRotation;
+			fields.nextFigure = piece.figure;
+			fields.nextRotation = piece.rotation;
+			fields.position = { PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW };
+		}
+
+		bool CheckIsPieceCanMove(const EngineFields& fields)
+		{
+			return !fields.board.IsCollision(fields.currentFigure, fields.rotation, fields.position.x,
+				fields.position.y + 1);
+		}
+
+		bool CheckIsPieceCanMove(const EngineFields& fields, Direction direction)
+		{
+			return !fields.board.IsCollision(fields.currentFigure, fields.rotation, fields.position.x + (int)direction,
+				fields.position.y);
+		}
+
+		int CalculateNextRotation(const EngineFields& fields)
+		{
+			if (fields.rotation < PIECE_ROTATIONS - 1)
+			{
+				return fields.rotation + 1;
+			}
+			else
+			{
+				return 0;
+			}
+		}
+
+		PieceRotation CheckIsPieceCanRotate(const EngineFields& fields)
+		{
+			int nextRotation{ CalculateNextRotation(fields) };
+			int xIndex{ Engine::CalculateRotatedX(fields.currentFigure, nextRotation, fields.position.x) };
+
+			PieceRotation pieceRotaion{};
+
+			if (fields.board.IsCollision(fields.currentFigure, nextRotation, xIndex, fields.position.y))
+			{
+				pieceRotaion.pieceCanRotate = false;
+				return pieceRotaion;
+			}
+
+			pieceRotaion.pieceShift = xIndex - fields.position.x;
+
+			pieceRotaion.nextRotation = nextRotation;
+			pieceRotaion.pieceCanRotate = true;
+
+			return pieceRotaion;
+		}
+
+		void CheckIsGameOver(const EngineFields& fields)
+		{
+			if (fields.board.IsCollision(fields.currentFigure, fields.rotation, fields.position.x, fields.position.y))
+			{
+				fields.gameOver = true;
+			}
+		}
+
+		void AddFrame(const EngineFields& fields)
+		{
+			if (fields.currentFrame == GRAVITY_TICKS)
+			{
+				fields.currentFrame = 0;
+			}
+			else
+			{
+				fields.currentFrame++;
+			}
+		}
+
+		void AddScore(const EngineFields& fields)
+		{
+			if (fields.score + SCORE_ADDITION <= SCORE_MAX_VALUE)
+			{
+				fields.score += SCORE_ADDITION;
+			}
+		}
+
+		void DeleteLines(const EngineFields& fields)
+		{
+			if (!fields.profile.HasFullRows())
+			{
+				return;
+			}
+
+			ClearedLines clearedRows{ fields.board.ClearFullRows() };
+
+			fields.profile.ClearRows(fields.board, clearedRows);
+
+			for (int i{}; i < clearedRows.count; i++)
+			{
+				AddScore(fields);
+			}
+
+			fields.clearedLines += clearedRows.count;
+		}
+
+		void SaveCurrentPiece(const EngineFields& fields)
+		{
+			fields.board.Place(fields.currentFigure, fields.rotation, fields.position.x, fields.position.y);
+			fields.profile.Place(fields.currentFigure, fields.rotation, fields.position.x, fields.position.y);
+			fields.boardVersion++;
+			fields.lockedPieces++;
+		}
+
+		void LockPiece(const EngineFields& fields)
+		{
+			SaveCurrentPiece(fields);
+
+			SpawnNextPiece(fields);
+
+			DeleteLines(fields);
+			CheckIsGameOver(fields);
+		}
+
+		void GoToNextPiece(const EngineFields& fields)
+		{
+			if (fields.currentFrame == GRAVITY_TICKS)
+			{
+				LockPiece(fields);
+			}
+		}
+
+		void MovePiece(const EngineFields& fields, PieceMovement movement)
+		{
+			PieceRotation pieceRotation{};
+
+			switch (movement)
+			{
+			case PieceMovement::Left:
+
+				if (CheckIsPieceCanMove(fields, Direction::Left))
+				{
+					fields.position.x--;
+				}
+				break;
+
+			case PieceMovement::Right:
+
+				if (CheckIsPieceCanMove(fields, Direction::Right))
+				{
+					fields.position.x++;
+				}
+				break;
+
+			case PieceMovement::Rotation:
+
+				pieceRotation = CheckIsPieceCanRotate(fields);
+
+				if (pieceRotation.pieceCanRotate)
+				{
+					fields.position.x += pieceRotation.pieceShift;
+					fields.rotation = pieceRotation.nextRotation;
+				}
+				break;
+
+			case PieceMovement::SpeedUp:
+
+				if (CheckIsPieceCanMove(fields))
+				{
+					fields.position.y++;
+				}
+				else
+				{
+					GoToNextPiece(fields);
+				}
+
+				break;
+
+			case PieceMovement::HardDrop:
+
+				fields.position.y = CalculateGhostRow(fields.board, fields.profile, fields.currentFigure,
+					fields.rotation, fields.position);
+				LockPiece(fields);
+
+				break;
+
+			case PieceMovement::None:
+
+				if (CheckIsPieceCanMove(fields))
+				{
+					if (fields.currentFrame == GRAVITY_TICKS)
+					{
+						fields.position.y++;
+					}
+				}
+				else
+				{
+					GoToNextPiece(fields);
+				}
+
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+	Engine::Engine(uint64_t seed, RandomizerKind randomizerKind)
+	{
+		Reset(seed, randomizerKind);
+	}
+
+	void Engine::Reset(uint64_t seed, RandomizerKind randomizerKind)
+	{
+		Reset(GetFields(), seed, randomizerKind);
+	}
+
+	void Engine::Tick(PieceMovement movement)
+	{
+		Tick(GetFields(), movement);
+	}
+
+	void Engine::Tick(const PieceMovement* movements, int count)
+	{
+		Tick(GetFields(), movements, count);
+	}
+
+	void Engine::Reset(const EngineFields& fields, uint64_t seed, RandomizerKind randomizerKind)
+	{
+		fields.seed = seed;
+		fields.randomizer.Reset(seed, randomizerKind);
+
+		fields.board.Clear();
+		fields.profile.Reset(fields.board);
+		fields.boardVersion++;
+
+		SpawnedPiece piece{ fields.randomizer.Next() };
+		fields.nextFigure = piece.figure;
+		fields.nextRotation = piece.rotation;
+
+		SpawnNextPiece(fields);
+
+		fields.currentFrame = 0;
+		fields.score = 0;
+		fields.lockedPieces = 0;
+		fields.clearedLines = 0;
+		fields.gameOver = false;
+	}
+
+	void Engine::Tick(const EngineFields& fields, PieceMovement movement)
+	{
+		if (!fields.gameOver)
+		{
+			MovePiece(fields, movement);
+		}
+
+		AddFrame(fields);
+	}
+
+	void Engine::Tick(const EngineFields& fields, const PieceMovement* movements, int count)
+	{
+		if (count == 0)
+		{
+			Tick(fields, PieceMovement::None);
+			return;
+		}
+
+		for (int i{}; i < count && !fields.gameOver; i++)
+		{
+			MovePiece(fields, movements[i]);
+		}
+
+		AddFrame(fields);
+	}
+
+	bool Engine::IsGameOver() const
+	{
+		return gameOver;
+	}
+
+	const Bitboard& Engine::GetBoard() const
+	{
+		return board;
+	}
+
+	const BoardProfile& Engine::GetProfile() const
+	{
+		return profile;
+	}
+
+	FigureKind Engine::GetCurrentFigure() const
+	{
+		return currentFigure;
+	}
+
+	FigureKind Engine::GetNextFigure() const
+	{
+		return nextFigure;
+	}
+
+	size_t Engine::GetRotation() const
+	{
+		return rotation;
+	}
+
+	size_t Engine::GetNextRotation() const
+	{
+		return nextRotation;
+	}
+
+	PiecePosition Engine::GetPosition() const
+	{
+		return position;
+	}
+
+	int Engine::GetGhostRow() const
+	{
+		return CalculateGhostRow(board, profile, currentFigure, rotation, position);
+	}
+
+	int Engine::GetScore() const
+	{
+		return score;
+	}
+
+	long long Engine::GetLockedPieces() const
+	{
+		return lockedPieces;
+	}
+
+	long long Engine::GetClearedLines() const
+	{
+		return clearedLines;
+	}
+
+	long long Engine::GetBoardVersion() const
+	{
+		return boardVersion;
+	}
+
+	uint64_t Engine::GetHash() const
+	{
+		return board.GetHash() ^ GetPieceHash(currentFigure, rotation, position.x, position.y);
+	}
+
+	uint64_t Engine::GetSeed() const
+	{
+		return seed;
+	}
+
+	RandomizerKind Engine::GetRandomizerKind() const
+	{
+		return randomizer.GetKind();
+	}
+
+	int Engine::CalculateRotatedX(FigureKind figure, size_t nextRotation, int x)
+	{
+		int leftShift
+		{
+			x
+			+
+			GetPieceLayout(figure, nextRotation).width + 1
+			-
+			BOARD_WIDTH_IN_BLOCKS
+		};
+
+		if (leftShift < 0)
+		{
+			leftShift = 0;
+		}
+
+		x -= leftShift;
+
+		int rightShift{ 0 - x + 1 };
+
+		if (rightShift < 0)
+		{
+			rightShift = 0;
+		}
+
+		return x + rightShift;
+	}
+
+	EngineFields Engine::GetFields()
+	{
+		return { board, profile, randomizer, seed, currentFigure, nextFigure, rotation, nextRotation, position,
+			currentFrame, score, lockedPieces, clearedLines, boardVersion, gameOver };
+	}
+}
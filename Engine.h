@@ -0,0 +1,98 @@
+#pragma once
+#include "EngineConstants.h"
+#include "Bitboard.h"
+#include "BoardProfile.h"
+#include "Randomizer.h"
+
+namespace GameNamespace
+{
+	struct PiecePosition
+	{
+		int x{};
+		int y{};
+	};
+
+	// The state of one game, as references to wherever it is stored. The
+	// rules only work through it, so they run the same on the members of an
+	// Engine and on one slot of the per-field arrays of a VectorEnvironment.
+	struct EngineFields
+	{
+		Bitboard& board;
+		BoardProfile& profile;
+		PieceRandomizer& randomizer;
+		uint64_t& seed;
+		FigureKind& currentFigure;
+		FigureKind& nextFigure;
+		size_t& rotation;
+		size_t& nextRotation;
+		PiecePosition& position;
+		int& currentFrame;
+		int& score;
+		long long& lockedPieces;
+		long long& clearedLines;
+		long long& boardVersion;
+		bool& gameOver;
+	};
+
+	// The rules of the game with no dependency on SDL or the window: the board,
+	// the falling piece, gravity, locking, line clears, scoring and game over.
+	// Time advances one logic tick per call to Tick.
+	class Engine
+	{
+	public:
+		Engine(uint64_t seed = 0, RandomizerKind randomizerKind = RandomizerKind::Uniform);
+
+		void Reset(uint64_t seed, RandomizerKind randomizerKind = RandomizerKind::Uniform);
+		void Tick(PieceMovement movement);
+		void Tick(const PieceMovement* movements, int count);
+
+		// The same rules on a game stored elsewhere.
+		static void Reset(const EngineFields& fields, uint64_t seed, RandomizerKind randomizerKind);
+		static void Tick(const EngineFields& fields, PieceMovement movement);
+		static void Tick(const EngineFields& fields, const PieceMovement* movements, int count);
+
+		bool IsGameOver() const;
+		const Bitboard& GetBoard() const;
+		const BoardProfile& GetProfile() const;
+		FigureKind GetCurrentFigure() const;
+		FigureKind GetNextFigure() const;
+		size_t GetRotation() const;
+		size_t GetNextRotation() const;
+		PiecePosition GetPosition() const;
+		// The row the falling piece would land in, where the ghost piece is
+		// drawn and where a hard drop locks it.
+		int GetGhostRow() const;
+		int GetScore() const;
+		long long GetLockedPieces() const;
+		long long GetClearedLines() const;
+		long long GetBoardVersion() const;
+		// Zobrist hash of the locked blocks and the falling piece.
+		uint64_t GetHash() const;
+		uint64_t GetSeed() const;
+		RandomizerKind GetRandomizerKind() const;
+
+		// Column a piece at x ends up in when turned to nextRotation: it is
+		// pushed back inside the walls if the new shape would stick out.
+		static int CalculateRotatedX(FigureKind figure, size_t nextRotation, int x);
+
+	private:
+		Bitboard board{};
+		BoardProfile profile{};
+		PieceRandomizer randomizer{};
+		uint64_t seed{};
+		FigureKind currentFigure{};
+		FigureKind nextFigure{};
+		size_t rotation{};
+		size_t nextRotation{};
+		PiecePosition position{ PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW };
+
+		int currentFrame{};
+		int score{};
+		long long lockedPieces{};
+		long long clearedLines{};
+		long long boardVersion{};
+		bool gameOver{};
+
+		EngineFields GetFields();
+	};
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "Pieces.h"
+
+namespace GameNamespace
+{
+    const int
+        BOARD_WIDTH_IN_BLOCKS{ 11 },
+        BOARD_HEIGHT_IN_BLOCKS{ 23 },
+
+        PIECE_INITIAL_COLUMN{ 4 },
+        PIECE_INITIAL_ROW{ 0 },
+
+        // The piece falls once every GRAVITY_TICKS + 1 ticks: 55 ticks, 367 ms
+        // at 150 ticks per second, the step of the original 6 ms frame loop.
+        GRAVITY_TICKS{ 54 },
+
+        SCORE_ADDITION{ 9 },
+        SCORE_MAX_VALUE{ 99999 };
+
+    enum class Direction
+    {
+        Left = -1,
+        Right = 1
+    };
+
+    enum class PieceMovement
+    {
+        None,
+        Left,
+        Right,
+        Rotation,
+        SpeedUp,
+        HardDrop,
+    };
+
+    struct PieceRotation 
+    {
+        int pieceShift{};
+        bool pieceCanRotate{};
+        int nextRotation{};
+    };
+}
@@ -0,0 +1,86 @@
+#include "Evaluation.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const BoardRow INTERIOR_ROW_MASK{ FULL_ROW_MASK & ~WALLS_ROW_MASK };
+
+		int CountBlocks(BoardRow row)
+		{
+			return (int)std::bitset<16>{ row }.count();
+		}
+
+		void AddSurfaceFeatures(const std::array<int, BOARD_WIDTH_IN_BLOCKS>& heights, BoardFeatures& features)
+		{
+			for (int x{ 1 }; x < BOARD_WIDTH_IN_BLOCKS - 1; x++)
+			{
+				int wellDepth{ std::min(heights[x - 1], heights[x + 1]) - heights[x] };
+
+				features.aggregateHeight += heights[x];
+				features.wells += std::max(wellDepth, 0);
+
+				if (x > 1)
+				{
+					features.bumpiness += std::abs(heights[x] - heights[x - 1]);
+				}
+			}
+		}
+	}
+
+	BoardFeatures CalculateBoardFeatures(const Bitboard& board)
+	{
+		std::array<int, BOARD_WIDTH_IN_BLOCKS> heights{};
+		BoardFeatures features{};
+		BoardRow covered{};
+
+		for (int y{}; y < BOARD_HEIGHT_IN_BLOCKS - 1; y++)
+		{
+			BoardRow row{ (BoardRow)(board.GetRow(y) & INTERIOR_ROW_MASK) };
+			BoardRow columnTops{ (BoardRow)(row & ~covered) };
+
+			features.holes += CountBlocks(covered & ~row);
+			covered |= row;
+
+			for (int x{ 1 }; columnTops != 0; x++)
+			{
+				if ((columnTops >> x & 1) != 0)
+				{
+					heights[x] = BOARD_HEIGHT_IN_BLOCKS - 1 - y;
+					columnTops &= ~(1 << x);
+				}
+			}
+		}
+
+		heights[0] = BOARD_HEIGHT_IN_BLOCKS - 1;
+		heights[BOARD_WIDTH_IN_BLOCKS - 1] = BOARD_HEIGHT_IN_BLOCKS - 1;
+
+		AddSurfaceFeatures(heights, features);
+
+		return features;
+	}
+
+	BoardFeatures CalculateBoardFeatures(const BoardProfile& profile)
+	{
+		BoardFeatures features{};
+
+		features.holes = profile.GetHoles();
+		AddSurfaceFeatures(profile.GetHeights(), features);
+
+		return features;
+	}
+
+	double EvaluateBoard(const Bitboard& board, int clearedLines, const EvaluationWeights& weights)
+	{
+		BoardFeatures features{ CalculateBoardFeatures(board) };
+
+		return weights.aggregateHeight * features.aggregateHeight
+			+ weights.holes * features.holes
+			+ weights.bumpiness * features.bumpiness
+			+ weights.wells * features.wells
+			+ weights.clearedLines * clearedLines;
+	}
+}
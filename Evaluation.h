@@ -0,0 +1,33 @@
+#pragma once
+#include "Bitboard.h"
+#include "BoardProfile.h"
+
+namespace GameNamespace
+{
+	// Weights of the board features; higher scores are better.
+	struct EvaluationWeights
+	{
+		double aggregateHeight{ -0.510066 };
+		double holes{ -0.35663 };
+		double bumpiness{ -0.184483 };
+		double wells{ -0.1 };
+		double clearedLines{ 0.760666 };
+	};
+
+	// Heights are counted from the floor. A hole is an empty cell with a
+	// block somewhere above it. Bumpiness sums the height steps between
+	// neighbouring columns, wells the depth of columns lower than both
+	// neighbours (walls count as full height).
+	struct BoardFeatures
+	{
+		int aggregateHeight{};
+		int holes{};
+		int bumpiness{};
+		int wells{};
+	};
+
+	BoardFeatures CalculateBoardFeatures(const Bitboard& board);
+	// The same features from a profile kept up to date, without a scan.
+	BoardFeatures CalculateBoardFeatures(const BoardProfile& profile);
+	double EvaluateBoard(const Bitboard& board, int clearedLines, const EvaluationWeights& weights);
+}
@@ -0,0 +1,50 @@
+#include "FixedTimestep.h"
+
+namespace GameNamespace
+{
+	FixedTimestep::FixedTimestep(int ticksPerSecond, int maxTicksPerAdvance)
+	{
+		this->ticksPerSecond = ticksPerSecond;
+		this->maxTicksPerAdvance = maxTicksPerAdvance;
+
+		frequency = SDL_GetPerformanceFrequency();
+
+		Reset();
+	}
+
+	void FixedTimestep::Reset()
+	{
+		lastCounter = SDL_GetPerformanceCounter();
+		accumulator = 0;
+	}
+
+	int FixedTimestep::Advance()
+	{
+		Uint64 counter{ SDL_GetPerformanceCounter() };
+
+		accumulator += (counter - lastCounter) * ticksPerSecond;
+		lastCounter = counter;
+
+		Uint64 ticks{ accumulator / frequency };
+		accumulator %= frequency;
+
+		// After a stall longer than maxTicksPerAdvance ticks the rest is
+		// dropped instead of being replayed in a burst.
+		if (ticks > (Uint64)maxTicksPerAdvance)
+		{
+			ticks = maxTicksPerAdvance;
+		}
+
+		return (int)ticks;
+	}
+
+	double FixedTimestep::GetInterpolation() const
+	{
+		return (double)accumulator / frequency;
+	}
+
+	Uint32 FixedTimestep::GetMillisecondsToNextTick() const
+	{
+		return (Uint32)((frequency - accumulator) * 1000 / ((Uint64)ticksPerSecond * frequency));
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <SDL.h>
+
+namespace GameNamespace
+{
+	// Converts elapsed wall time into a whole number of logic ticks at an exact
+	// rate. Time is kept in performance counter units scaled by the tick rate,
+	// so no rounding error accumulates however long the game runs.
+	class FixedTimestep
+	{
+	public:
+		FixedTimestep(int ticksPerSecond, int maxTicksPerAdvance);
+
+		void Reset();
+		int Advance();
+		double GetInterpolation() const;
+		Uint32 GetMillisecondsToNextTick() const;
+
+	private:
+		int ticksPerSecond{};
+		int maxTicksPerAdvance{};
+		Uint64 frequency{};
+		Uint64 lastCounter{};
+		Uint64 accumulator{};
+	};
+}
@@ -0,0 +1,145 @@
+#include "FramePacer.h"
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace GameNamespace
+{
+	namespace
+	{
+		void Relax()
+		{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+			_mm_pause();
+#elif defined(__aarch64__)
+			asm volatile("yield");
+#endif
+		}
+	}
+
+	FramePacer::FramePacer(int framesPerSecond, bool isVSync)
+	{
+		this->isVSync = isVSync;
+
+		frequency = SDL_GetPerformanceFrequency();
+
+		SetFramesPerSecond(framesPerSecond);
+	}
+
+	void FramePacer::SetFramesPerSecond(int framesPerSecond)
+	{
+		this->framesPerSecond = framesPerSecond;
+
+		period = frequency / framesPerSecond;
+
+		Restart();
+	}
+
+	int FramePacer::GetFramesPerSecond() const
+	{
+		return framesPerSecond;
+	}
+
+	bool FramePacer::IsVSync() const
+	{
+		return isVSync;
+	}
+
+	void FramePacer::Restart()
+	{
+		lastFrameEnd = SDL_GetPerformanceCounter();
+		deadline = lastFrameEnd + period;
+	}
+
+	void FramePacer::EndFrame()
+	{
+		if (!isVSync)
+		{
+			Uint64 counter{ SDL_GetPerformanceCounter() };
+
+			if (counter >= deadline)
+			{
+				deadline = counter;
+			}
+			else
+			{
+				WaitUntil(deadline);
+			}
+
+			deadline += period;
+		}
+
+		Uint64 frameEnd{ SDL_GetPerformanceCounter() };
+
+		RecordFrame(frameEnd - lastFrameEnd);
+		lastFrameEnd = frameEnd;
+	}
+
+	const std::array<long long, JITTER_HISTOGRAM_BINS>& FramePacer::GetHistogram() const
+	{
+		return histogram;
+	}
+
+	long long FramePacer::GetFrames() const
+	{
+		return frames;
+	}
+
+	double FramePacer::GetAverageFrameMilliseconds() const
+	{
+		return frames == 0 ? 0 : frameTimeSum / frames * 1000 / frequency;
+	}
+
+	double FramePacer::GetFrameDeviationMilliseconds() const
+	{
+		if (frames == 0)
+		{
+			return 0;
+		}
+
+		double average{ frameTimeSum / frames };
+		double variance{ frameTimeSquareSum / frames - average * average };
+
+		return std::sqrt(variance > 0 ? variance : 0) * 1000 / frequency;
+	}
+
+	double FramePacer::GetWorstFrameMilliseconds() const
+	{
+		return (double)worstFrameTime * 1000 / frequency;
+	}
+
+	void FramePacer::WaitUntil(Uint64 counter)
+	{
+		Uint64 spinLength{ frequency * FRAME_PACER_SPIN_MICROSECONDS / 1000000 };
+		Uint64 now{ SDL_GetPerformanceCounter() };
+
+		while (now + spinLength < counter)
+		{
+			SDL_Delay(1);
+			now = SDL_GetPerformanceCounter();
+		}
+
+		while (now < counter)
+		{
+			Relax();
+			now = SDL_GetPerformanceCounter();
+		}
+	}
+
+	void FramePacer::RecordFrame(Uint64 frameTime)
+	{
+		double missed{ ((double)frameTime - (double)period) * 1000000 / frequency };
+		long long bin{ JITTER_HISTOGRAM_BINS / 2 + (long long)std::floor(missed / JITTER_BIN_MICROSECONDS + 0.5) };
+
+		bin = bin < 0 ? 0 : bin;
+		bin = bin >= JITTER_HISTOGRAM_BINS ? JITTER_HISTOGRAM_BINS - 1 : bin;
+		histogram[bin]++;
+
+		frames++;
+		frameTimeSum += (double)frameTime;
+		frameTimeSquareSum += (double)frameTime * frameTime;
+		worstFrameTime = frameTime > worstFrameTime ? frameTime : worstFrameTime;
+	}
+}
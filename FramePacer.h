@@ -0,0 +1,58 @@
+#pragma once
+#include <SDL.h>
+#include <array>
+
+namespace GameNamespace
+{
+	const int
+		FRAME_PACER_SPIN_MICROSECONDS{ 2000 },
+		JITTER_HISTOGRAM_BINS{ 33 },
+		JITTER_BIN_MICROSECONDS{ 250 };
+
+	// Ends every frame on a fixed grid of the performance counter. The wait
+	// sleeps in whole milliseconds while the deadline is further away than
+	// the scheduler can be trusted with, then spins for the rest. A frame
+	// that comes in late moves the grid instead of being made up for. With
+	// VSync the present already waits, so frames are only measured.
+	//
+	// The histogram counts frame times by how far they missed the target,
+	// JITTER_BIN_MICROSECONDS per bin, the middle bin being on time and the
+	// outer ones collecting everything beyond.
+	class FramePacer
+	{
+	public:
+		FramePacer(int framesPerSecond, bool isVSync);
+
+		void SetFramesPerSecond(int framesPerSecond);
+		int GetFramesPerSecond() const;
+		bool IsVSync() const;
+
+		// Starts the grid anew from now, when frames begin or resume.
+		void Restart();
+		// Called after each present.
+		void EndFrame();
+
+		const std::array<long long, JITTER_HISTOGRAM_BINS>& GetHistogram() const;
+		long long GetFrames() const;
+		double GetAverageFrameMilliseconds() const;
+		double GetFrameDeviationMilliseconds() const;
+		double GetWorstFrameMilliseconds() const;
+
+	private:
+		int framesPerSecond{};
+		bool isVSync{};
+		Uint64 frequency{};
+		Uint64 period{};
+		Uint64 deadline{};
+		Uint64 lastFrameEnd{};
+
+		std::array<long long, JITTER_HISTOGRAM_BINS> histogram{};
+		long long frames{};
+		double frameTimeSum{};
+		double frameTimeSquareSum{};
+		Uint64 worstFrameTime{};
+
+		void WaitUntil(Uint64 counter);
+		void RecordFrame(Uint64 frameTime);
+	};
+}
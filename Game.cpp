@@ -1,14 +1,15 @@
 #include "Game.h"
 #include "GameExceptions.h"
-#include <time.h>
 #include <stdio.h>
 #include <iostream>
 #include <string>
 #include <SDL_image.h>
+#include <filesystem>
+#include <cmath>
 
 namespace GameNamespace
 {
-	Game::Game()
+	Game::Game(const RenderOptions& options)
 	{
 		if (SDL_Init(SDL_INIT_EVERYTHING))
 		{
@@ -21,7 +22,7 @@ namespace GameNamespace
 			SDL_WINDOWPOS_CENTERED,
 			WINDOW_WIDTH,
 			WINDOW_HEIGHT,
-			0
+			options.backend == RenderBackend::OpenGL ? SDL_WINDOW_OPENGL : 0
 		);
 
 		if (window == NULL)
@@ -29,11 +30,26 @@ namespace GameNamespace
 			throw WindowCreationException();
 		}
 
-		renderer = SDL_CreateRenderer(window, -1, 0);
-
-		if (renderer == NULL)
+		if (options.backend == RenderBackend::OpenGL)
 		{
-			throw RenderCreationException();
+			openGL = std::make_unique<OpenGLRenderer>(window, WINDOW_WIDTH, WINDOW_HEIGHT, options.isVSync);
+		}
+		else
+		{
+			Uint32 flags{ options.isVSync ? (Uint32)SDL_RENDERER_PRESENTVSYNC : 0 };
+
+			// Any renderer will do when there is no accelerated one.
+			renderer = SDL_CreateRenderer(window, -1, flags | SDL_RENDERER_ACCELERATED);
+
+			if (renderer == NULL)
+			{
+				renderer = SDL_CreateRenderer(window, -1, flags);
+			}
+
+			if (renderer == NULL)
+			{
+				throw RenderCreationException();
+			}
 		}
 
 		if (TTF_Init() == -1)
@@ -49,19 +65,31 @@ namespace GameNamespace
 			throw FontNullReference();
 		}
 
-		blockTexture = LoadTexture(BLOCK_TEXTURE_FILE_PATH);
-		backgroundTexture = LoadTexture(BACKGROUND_TEXTURE_FILE_PATH);
-		boardTexture = LoadTexture(BOARD_TEXTURE_FILE_PATH);
-		infoBlockTexture = LoadTexture(INFO_BLOCK_TEXTURE_FILE_PATH);
-
-		if (SDL_SetTextureAlphaMod(boardTexture, 100))
+		if (openGL)
 		{
-			throw SetTextureAlphaModException();
+			openGLBlockTexture = LoadOpenGLTexture(BLOCK_TEXTURE_FILE_PATH);
+			openGLBackgroundTexture = LoadOpenGLTexture(BACKGROUND_TEXTURE_FILE_PATH);
+			openGLBoardTexture = LoadOpenGLTexture(BOARD_TEXTURE_FILE_PATH);
+			openGLInfoBlockTexture = LoadOpenGLTexture(INFO_BLOCK_TEXTURE_FILE_PATH);
 		}
+		else
+		{
+			blockTexture = LoadTexture(BLOCK_TEXTURE_FILE_PATH);
+			backgroundTexture = LoadTexture(BACKGROUND_TEXTURE_FILE_PATH);
+			boardTexture = LoadTexture(BOARD_TEXTURE_FILE_PATH);
+			infoBlockTexture = LoadTexture(INFO_BLOCK_TEXTURE_FILE_PATH);
 
-		SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+			if (SDL_SetTextureAlphaMod(boardTexture, BOARD_TEXTURE_ALPHA))
+			{
+				throw SetTextureAlphaModException();
+			}
+
+			SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-		srand(time(NULL));
+			blockBatch = std::make_unique<BlockBatch>(renderer, blockTexture, BLOCK_SIZE, BLOCK_BATCH_CAPACITY);
+
+			CreateBoardCache();
+		}
 
 		menuButton = std::make_unique<Button>(
 			MENU_BUTTON_POINT,
@@ -70,11 +98,132 @@ namespace GameNamespace
 			renderer, 
 			"Play", 
 			sceneFont, 
-			BUTTON_FONT_COLOR);
+			BUTTON_FONT_COLOR,
+			openGL.get());
+
+		botButton = std::make_unique<Button>(
+			BOT_BUTTON_POINT,
+			BUTTON_HEIGHT,
+			BUTTON_WIDTH,
+			renderer,
+			"Bot",
+			sceneFont,
+			BUTTON_FONT_COLOR,
+			openGL.get());
+
+		textRenderer = std::make_unique<TextRenderer>(renderer, openGL.get());
+		textRenderer->LoadFont(sceneFont);
+
+		gameOverMessage = textRenderer->AddStaticText(gameOverFont, "GAME OVER!", MAIN_FONT_COLOR);
+		startAgainMessage = textRenderer->AddStaticText(
+			sceneFont, "Press Enter to start again", MAIN_FONT_COLOR);
+		gamePausedMessage = textRenderer->AddStaticText(gameOverFont, "GAME PAUSED", MAIN_FONT_COLOR);
+		resumeGameMessage = textRenderer->AddStaticText(
+			sceneFont, "Press Enter or Escape to resume game", MAIN_FONT_COLOR);
+
+		framePacer = std::make_unique<FramePacer>(
+			options.framesPerSecond > 0 ? options.framesPerSecond : GetRefreshRate(),
+			options.isVSync);
+
+		if (openGL)
+		{
+			StartRenderThread();
+		}
 	}
 
 	Game::~Game()
 	{
+		StopRenderThread();
+		SaveReplay();
+
+		SDL_Log(
+			"Input queue: %lld actions queued, %lld dropped",
+			inputQueue.GetPushedCount(),
+			inputQueue.GetDroppedCount());
+
+		if (bot)
+		{
+			SDL_Log(
+				"Bot: %lld pieces planned, %lld over budget, longest plan %lld us",
+				bot->GetPlannedPieces(),
+				bot->GetOverBudgetPieces(),
+				(long long)bot->GetLongestPlan().count());
+
+			if (bot->GetBeamSearch() != nullptr)
+			{
+				const BeamSearchStatistics& statistics{ bot->GetBeamSearch()->GetStatistics() };
+
+				SDL_Log(
+					"Beam search: %.0f nodes/s, %.2f levels and %.1f boards expanded per piece",
+					statistics.GetNodesPerSecond(),
+					statistics.GetAverageLevels(),
+					statistics.GetAverageBeamSize());
+
+				if (const TranspositionTable* table{ bot->GetBeamSearch()->GetTranspositionTable() })
+				{
+					SDL_Log(
+						"Transposition table: %zu MB, %.1f%% of %lld probes hit",
+						table->GetMemoryBytes() / (1024 * 1024),
+						statistics.GetTranspositionHitRate() * 100,
+						statistics.transpositionProbes);
+				}
+			}
+		}
+
+		if (blockBatch && blockBatch->GetFrames() > 0)
+		{
+			SDL_Log(
+				"Block batch: %.2f draw calls and %.0f vertices per frame, at most %d vertices in a frame%s",
+				(double)blockBatch->GetDrawCalls() / blockBatch->GetFrames(),
+				(double)blockBatch->GetVertices() / blockBatch->GetFrames(),
+				blockBatch->GetMostFrameVertices(),
+				blockBatch->IsGeometrySupported() ? "" : ", without geometry support");
+		}
+
+		if (openGL && openGL->GetFrames() > 0)
+		{
+			SDL_Log(
+				"OpenGL: %.2f draw calls and %.0f instances per frame, %lld instances dropped, %s instance buffer",
+				(double)openGL->GetDrawCalls() / openGL->GetFrames(),
+				(double)openGL->GetInstances() / openGL->GetFrames(),
+				openGL->GetDroppedInstances(),
+				openGL->IsBufferPersistent() ? "persistent mapped" : "orphaned");
+		}
+
+		if (presentedFrames > 0)
+		{
+			double frequency{ (double)SDL_GetPerformanceFrequency() };
+
+			SDL_Log(
+				"Rendering: %lld frames, snapshot age at present %.2f ms on average, %.2f ms at most",
+				presentedFrames,
+				totalSnapshotAge * 1000 / frequency / presentedFrames,
+				longestSnapshotAge * 1000 / frequency);
+		}
+
+		if (idleWaits > 0)
+		{
+			SDL_Log("Rendering: slept %lld times on a still or hidden screen", idleWaits);
+		}
+
+		if (framePacer->GetFrames() > 0)
+		{
+			SDL_Log(
+				"Frame pacing: %d fps%s, %.3f ms per frame, %.3f ms deviation, %.3f ms at most",
+				framePacer->GetFramesPerSecond(),
+				framePacer->IsVSync() ? " with VSync" : "",
+				framePacer->GetAverageFrameMilliseconds(),
+				framePacer->GetFrameDeviationMilliseconds(),
+				framePacer->GetWorstFrameMilliseconds());
+		}
+
+		blockBatch.reset();
+		textRenderer.reset();
+		menuButton.reset();
+		botButton.reset();
+		SDL_DestroyTexture(boardCache);
+		openGL.reset();
+
 		SDL_DestroyWindow(window);
 		SDL_DestroyRenderer(renderer);
 		SDL_Quit();
@@ -84,7 +233,54 @@ namespace GameNamespace
 	{
 		SDL_Event event{};
 
-		SDL_PollEvent(&event);
+		// Errors of the render thread surface here, on the thread that can
+		// report them.
+		if (hasRenderFailed.load())
+		{
+			std::rethrow_exception(renderException);
+		}
+
+		while (SDL_PollEvent(&event))
+		{
+			HandleEvent(event);
+		}
+	}
+
+	void Game::HandleEvent(SDL_Event event)
+	{
+		if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+		{
+			isBoardCacheLost.store(true);
+			RequestRedraw();
+		}
+
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3)
+		{
+			isPacingOverlayVisible.store(!isPacingOverlayVisible.load());
+			RequestRedraw();
+		}
+
+		if (event.type == SDL_WINDOWEVENT)
+		{
+			switch (event.window.event)
+			{
+			case SDL_WINDOWEVENT_MINIMIZED:
+			case SDL_WINDOWEVENT_HIDDEN:
+				isWindowVisible.store(false);
+				break;
+
+			case SDL_WINDOWEVENT_SHOWN:
+			case SDL_WINDOWEVENT_RESTORED:
+			case SDL_WINDOWEVENT_MAXIMIZED:
+			case SDL_WINDOWEVENT_EXPOSED:
+				isWindowVisible.store(true);
+				RequestRedraw();
+				break;
+
+			default:
+				break;
+			}
+		}
 
 		switch (gameState)
 		{
@@ -109,23 +305,200 @@ namespace GameNamespace
 		}
 	}
 
+	bool Game::WaitForEvents(int timeoutMilliseconds)
+	{
+		SDL_Event event{};
+
+		if (!SDL_WaitEventTimeout(&event, timeoutMilliseconds))
+		{
+			HandleEvents();
+			return false;
+		}
+
+		HandleEvent(event);
+		HandleEvents();
+
+		return true;
+	}
+
+	void Game::PublishSnapshot(double interpolation)
+	{
+		RenderSnapshot& next{ snapshots.GetWriteSlot() };
+
+		next.gameState = gameState;
+		next.board = engine.GetBoard();
+		next.boardVersion = engine.GetBoardVersion();
+		next.figure = engine.GetCurrentFigure();
+		next.rotation = engine.GetRotation();
+		next.nextFigure = engine.GetNextFigure();
+		next.nextRotation = engine.GetNextRotation();
+		next.position = engine.GetPosition();
+		next.previousPosition = previousPosition;
+		next.isNewPiece = engine.GetLockedPieces() != previousLockedPieces;
+		next.ghostRow = engine.GetGhostRow();
+		next.score = engine.GetScore();
+		next.interpolation = interpolation;
+		next.publishedAt = SDL_GetPerformanceCounter();
+
+		snapshots.Publish();
+		RequestRedraw();
+	}
+
+	void Game::StartRenderThread()
+	{
+		// The context moves to the render thread with the drawing.
+		if (openGL)
+		{
+			openGL->MakeCurrent(false);
+		}
+
+		isRendering.store(true);
+		renderThread = std::thread{ &Game::RunRenderThread, this };
+	}
+
+	void Game::StopRenderThread()
+	{
+		if (!renderThread.joinable())
+		{
+			return;
+		}
+
+		isRendering.store(false);
+		RequestRedraw();
+		renderThread.join();
+
+		if (openGL)
+		{
+			openGL->MakeCurrent(true);
+		}
+	}
+
+	void Game::RunRenderThread()
+	{
+		try
+		{
+			if (openGL)
+			{
+				openGL->MakeCurrent(true);
+			}
+
+			while (isRendering.load())
+			{
+				if (!DrawFrame())
+				{
+					std::unique_lock<std::mutex> lock{ redrawMutex };
+
+					redrawReady.wait_for(lock, std::chrono::milliseconds{ IDLE_WAIT_MILLISECONDS },
+						[this] { return !isRendering.load() || ShouldRender(); });
+
+					idleWaits++;
+				}
+			}
+		}
+		catch (...)
+		{
+			renderException = std::current_exception();
+			hasRenderFailed.store(true);
+		}
+
+		if (openGL)
+		{
+			openGL->MakeCurrent(false);
+		}
+	}
+
+	void Game::RequestRedraw()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ redrawMutex };
+
+			isRedrawRequested.store(true);
+		}
+
+		redrawReady.notify_one();
+	}
+
+	// A running game moves between snapshots; the other screens only change
+	// with a new snapshot or when the window needs repainting. Nothing is
+	// drawn while the window cannot be seen.
+	bool Game::ShouldRender() const
+	{
+		if (!isWindowVisible.load())
+		{
+			return false;
+		}
+
+		return snapshot == nullptr
+			|| snapshot->gameState == GameState::Running
+			|| snapshots.HasNewValue()
+			|| isRedrawRequested.load();
+	}
+
+	bool Game::RenderFrame()
+	{
+		return !renderThread.joinable() && DrawFrame();
+	}
+
+	// The pacer starts its grid anew after any pause, so the time spent not
+	// drawing does not count as a late frame.
+	bool Game::DrawFrame()
+	{
+		if (!ShouldRender())
+		{
+			isFramePacerIdle = true;
+			return false;
+		}
+
+		if (isFramePacerIdle)
+		{
+			framePacer->Restart();
+			isFramePacerIdle = false;
+		}
+
+		isRedrawRequested.store(false);
+		Render();
+		framePacer->EndFrame();
+
+		return true;
+	}
+
 	void Game::Render()
 	{
-		SDL_RenderClear(renderer);
-		SDL_RenderCopy(renderer, backgroundTexture, NULL, NULL);
+		snapshot = &snapshots.Read();
 
-		switch (gameState)
+		// The game has moved on since the snapshot was taken; the piece is
+		// drawn as far along as it would be by now.
+		double ticksSincePublished{
+			(double)(SDL_GetPerformanceCounter() - snapshot->publishedAt)
+			* LOGIC_TICKS_PER_SECOND / SDL_GetPerformanceFrequency() };
+
+		interpolation = SDL_min(snapshot->interpolation + ticksSincePublished, 1.0);
+
+		if (openGL)
+		{
+			openGL->Clear();
+		}
+		else
+		{
+			SDL_RenderClear(renderer);
+		}
+
+		DrawTexture(backgroundTexture, openGLBackgroundTexture, NULL);
+
+		switch (snapshot->gameState)
 		{
 		case GameState::Running:
 			DrawBoard();
 			DrawFigure();
 			DrawScene();
+			FlushBlocks();
 			break;
 
 		case GameState::Paused:
 			DrawBoard();
 			DrawFigure();
 			DrawScene();
+			FlushBlocks();
 			PrintPauseGame();
 			break;
 
@@ -133,35 +506,87 @@ namespace GameNamespace
 			DrawBoard();
 			DrawFigure();
 			DrawScene();
+			FlushBlocks();
 			PrintGameOver();
 			break;
 
 		case GameState::MenuMode:
 			menuButton->RenderButton(renderer);
+			botButton->RenderButton(renderer);
 			break;
 
 		default:
 			break;
 		}
 
-		SDL_RenderPresent(renderer);
+		if (isPacingOverlayVisible.load())
+		{
+			DrawPacingOverlay();
+		}
+
+		if (openGL)
+		{
+			openGL->Present();
+		}
+		else
+		{
+			blockBatch->EndFrame();
+			SDL_RenderPresent(renderer);
+		}
+
+		if (snapshot->publishedAt != 0)
+		{
+			Uint64 age{ SDL_GetPerformanceCounter() - snapshot->publishedAt };
+
+			presentedFrames++;
+			totalSnapshotAge += age;
+			longestSnapshotAge = age > longestSnapshotAge ? age : longestSnapshotAge;
+		}
 	}
 
 	void Game::Update()
 	{
+		if (bridge && (gameState == GameState::Running || gameState == GameState::GameOver))
+		{
+			UpdateBridge();
+		}
+
 		switch (gameState)
 		{
 		case GameState::Running:
 
-			MovePiece();
+			previousPosition = engine.GetPosition();
+			previousLockedPieces = engine.GetLockedPieces();
+
+			if (bot)
+			{
+				inputQueue.Clear();
+				inputQueue.Push({ bot->GetNextMovement(engine), SDL_GetTicks() });
+			}
+
+			TickEngine();
+
+			if (engine.IsGameOver() || (replayPlayer && replayPlayer->IsFinished()))
+			{
+				gameState = GameState::GameOver;
+				SaveReplay();
+			}
+
+			break;
+
+		case GameState::GameOver:
+
+			// The bot runs unattended, so it starts the next game itself.
+			if (bot && ++gameOverTicks >= BOT_RESTART_DELAY_TICKS)
+			{
+				InitializeGame();
+			}
 
 			break;
 
 		default:
 			break;
 		}
-
-		AddFrame();
 	}
 
 	bool Game::IsRunning()
@@ -169,6 +594,59 @@ namespace GameNamespace
 		return gameState != GameState::Inactive;
 	}
 
+	// Screens where no tick changes anything: the bot restarts from the game
+	// over screen and the bridge answers the agent there, so those keep
+	// ticking.
+	bool Game::IsIdle() const
+	{
+		switch (gameState)
+		{
+		case GameState::MenuMode:
+		case GameState::Paused:
+			return true;
+
+		case GameState::GameOver:
+			return !bot && !bridge;
+
+		default:
+			return false;
+		}
+	}
+
+	void Game::StartReplay(const char* replayFilePath)
+	{
+		std::unique_ptr<ReplayPlayer> player{ std::make_unique<ReplayPlayer>() };
+
+		if (!player->Load(replayFilePath))
+		{
+			throw ReplayLoadException();
+		}
+
+		SaveReplay();
+
+		engine.Reset(player->GetSeed(), player->GetRandomizerKind());
+		replayPlayer = std::move(player);
+		bot.reset();
+
+		StartGame();
+	}
+
+	void Game::StartBridge(const char* bridgeName)
+	{
+		std::unique_ptr<AgentBridge> newBridge{ std::make_unique<AgentBridge>() };
+
+		if (!newBridge->Host(bridgeName))
+		{
+			throw BridgeHostException();
+		}
+
+		bridge = std::move(newBridge);
+		bridgeGames = 0;
+		bot.reset();
+
+		InitializeGame();
+	}
+
 	void Game::DrawBlock(POINT point, Color color)
 	{
 		SDL_Rect rect
@@ -183,17 +661,120 @@ namespace GameNamespace
 		SDL_RenderFillRect(renderer, &rect);
 	}
 
-	void Game::DrawBlock(POINT point, SDL_Texture* texture)
+	void Game::DrawBlock(int x, int y, Uint8 alpha)
 	{
-		SDL_Rect rect
+		if (openGL)
 		{
-			point.x,
-			point.y,
-			BLOCK_SIZE,
-			BLOCK_SIZE
+			SDL_Rect rect
+			{
+				x,
+				y,
+				BLOCK_SIZE,
+				BLOCK_SIZE
+			};
+
+			openGL->Draw(openGLBlockTexture, NULL, &rect, { 255, 255, 255, alpha });
+			return;
+		}
+
+		blockBatch->Add(x, y, alpha);
+	}
+
+	// The SDL textures carry their alpha as an alpha mod set when loaded.
+	void Game::DrawTexture(SDL_Texture* texture, size_t openGLTexture, const SDL_Rect* rectangle, Uint8 alpha)
+	{
+		if (openGL)
+		{
+			openGL->Draw(openGLTexture, NULL, rectangle, { 255, 255, 255, alpha });
+			return;
+		}
+
+		SDL_RenderCopy(renderer, texture, NULL, rectangle);
+	}
+
+	void Game::FillRectangle(const SDL_Rect* rectangle, SDL_Color color)
+	{
+		if (openGL)
+		{
+			openGL->FillRect(rectangle, color);
+			return;
+		}
+
+		SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+		SDL_RenderFillRect(renderer, rectangle);
+	}
+
+	void Game::FlushBlocks()
+	{
+		if (blockBatch)
+		{
+			blockBatch->Flush();
+		}
+	}
+
+	void Game::DrawOverlay()
+	{
+		FillRectangle(&BACKGROUND_RECTANGLE, OVERLAY_COLOR);
+	}
+
+	// Frame time statistics and a histogram of how far frames missed their
+	// target, on a log scale so that rare late frames still show.
+	void Game::DrawPacingOverlay()
+	{
+		const std::array<long long, JITTER_HISTOGRAM_BINS>& histogram{ framePacer->GetHistogram() };
+		long long mostFrames{ 1 };
+
+		for (long long frames : histogram)
+		{
+			mostFrames = frames > mostFrames ? frames : mostFrames;
+		}
+
+		char text[128]{};
+		int length{ SDL_snprintf(text, sizeof(text), "%d fps%s  %.3f ms  dev %.3f  max %.3f",
+			framePacer->GetFramesPerSecond(),
+			framePacer->IsVSync() ? " vsync" : "",
+			framePacer->GetAverageFrameMilliseconds(),
+			framePacer->GetFrameDeviationMilliseconds(),
+			framePacer->GetWorstFrameMilliseconds()) };
+
+		int textWidth{ SDL_min(length, (int)sizeof(text) - 1) * PACING_CHARACTER_WIDTH };
+		int histogramWidth{ JITTER_HISTOGRAM_BINS * PACING_BAR_WIDTH };
+
+		SDL_Rect panel
+		{
+			PACING_OVERLAY_X,
+			PACING_OVERLAY_Y,
+			SDL_max(textWidth, histogramWidth) + BLOCK_SIZE,
+			PACING_TEXT_HEIGHT + PACING_BAR_HEIGHT + BLOCK_SIZE
+		};
+
+		SDL_Rect textRectangle
+		{
+			PACING_OVERLAY_X + BLOCK_SIZE / 2,
+			PACING_OVERLAY_Y + BLOCK_SIZE / 4,
+			textWidth,
+			PACING_TEXT_HEIGHT
 		};
 
-		SDL_RenderCopy(renderer, texture, NULL, &rect);
+		FillRectangle(&panel, OVERLAY_COLOR);
+		textRenderer->DrawText(sceneFont, text, PACING_TEXT_COLOR, textRectangle);
+
+		int barsBottom{ panel.y + panel.h - BLOCK_SIZE / 4 };
+
+		for (int i{}; i < JITTER_HISTOGRAM_BINS; i++)
+		{
+			int height{ (int)(PACING_BAR_HEIGHT * std::log1p((double)histogram[i]) / std::log1p((double)mostFrames)) };
+
+			SDL_Rect bar
+			{
+				textRectangle.x + i * PACING_BAR_WIDTH,
+				barsBottom - height,
+				PACING_BAR_WIDTH - 1,
+				height
+			};
+
+			FillRectangle(&bar, i == JITTER_HISTOGRAM_BINS / 2 ? PACING_ON_TIME_COLOR : PACING_LATE_COLOR);
+		}
 	}
 
 	void Game::SetColor(Color color)
@@ -229,90 +810,170 @@ namespace GameNamespace
 		}
 	}
 
-	int Game::GetFrameDelay()
+	int Game::GetRefreshRate()
+	{
+		SDL_DisplayMode displayMode{};
+
+		if (SDL_GetWindowDisplayMode(window, &displayMode) || displayMode.refresh_rate <= 0)
+		{
+			return DEFAULT_REFRESH_RATE;
+		}
+
+		return displayMode.refresh_rate;
+	}
+
+	void Game::DrawFigure()
+	{
+		PiecePosition position{ snapshot->position };
+		PiecePosition previousPosition{ snapshot->previousPosition };
+		int x{ boardPosition.x + position.x * BLOCK_SIZE };
+		int y{ boardPosition.y + position.y * BLOCK_SIZE };
+
+		// Between two logic ticks the piece is drawn part way along its last
+		// step, unless that step was a new piece spawning.
+		if (snapshot->gameState == GameState::Running && !snapshot->isNewPiece)
+		{
+			x -= (int)((position.x - previousPosition.x) * BLOCK_SIZE * (1 - interpolation));
+			y -= (int)((position.y - previousPosition.y) * BLOCK_SIZE * (1 - interpolation));
+		}
+
+		// The ghost shows where a hard drop would put the piece.
+		int ghostRow{ snapshot->ghostRow };
+
+		if (snapshot->gameState == GameState::Running && ghostRow > position.y)
+		{
+			DrawFigure(snapshot->figure, snapshot->rotation,
+				boardPosition.x + position.x * BLOCK_SIZE, boardPosition.y + ghostRow * BLOCK_SIZE, GHOST_PIECE_ALPHA);
+		}
+
+		DrawFigure(snapshot->figure, snapshot->rotation, x, y);
+	}
+
+	void Game::DrawFigure(FigureKind figure, size_t rotation, int x, int y, Uint8 alpha)
+	{
+		for (const CellOffset& cell : GetPieceLayout(figure, rotation).cells)
+		{
+			DrawBlock(x + cell.x * BLOCK_SIZE, y + cell.y * BLOCK_SIZE, alpha);
+		}
+	}
+
+	void Game::DrawBoard()
 	{
-		return FRAME_DELAY;
+		// OpenGL draws the whole stack as instances and needs no cache.
+		if (boardCache == NULL)
+		{
+			DrawTexture(boardTexture, openGLBoardTexture, &BOARD_RECT, BOARD_TEXTURE_ALPHA);
+			DrawBoardBlocks(boardPosition);
+			return;
+		}
+
+		if (!isBoardBackgroundCached)
+		{
+			SDL_RenderCopy(renderer, boardTexture, NULL, &BOARD_RECT);
+		}
+
+		if (isBoardCacheLost.exchange(false))
+		{
+			cachedBoardVersion = -1;
+		}
+
+		if (cachedBoardVersion != snapshot->boardVersion)
+		{
+			UpdateBoardCache();
+		}
+
+		SDL_RenderCopy(renderer, boardCache, NULL, &BOARD_CACHE_RECT);
 	}
 
-	void Game::DrawFigure()
+	void Game::DrawBoardBlocks(POINT position)
 	{
-		int primalPosition{ currentFigurePosition.x };
-		POINT piecePosition{ currentFigurePosition };
+		int primalXPosition{ position.x };
+		POINT blockPosition{ position };
 
-		for (size_t i{}; i < Figures[static_cast<int>(currentFigure)][rotation].size(); i++)
+		for (int i{}; i < BOARD_HEIGHT_IN_BLOCKS; i++)
 		{
-			for (size_t j{}; j < Figures[static_cast<int>(currentFigure)][rotation][i].size(); j++)
+			for (int j{}; j < BOARD_WIDTH_IN_BLOCKS; j++)
 			{
-				if (Figures[static_cast<int>(currentFigure)][rotation][i][j] == 0)
+				if (snapshot->board.IsBlock(j, i))
 				{
-					piecePosition.x += BLOCK_SIZE;
-				}
-				else
-				{
-					DrawBlock(piecePosition, blockTexture);
-					piecePosition.x += BLOCK_SIZE;
+					DrawBlock(blockPosition.x, blockPosition.y);
 				}
+
+				blockPosition.x += BLOCK_SIZE;
 			}
 
-			piecePosition.y += BLOCK_SIZE;
-			piecePosition.x = primalPosition;
+			blockPosition.x = primalXPosition;
+			blockPosition.y += BLOCK_SIZE;
 		}
 	}
 
-	void Game::DrawFigure(FigureKind figure, size_t rotation, int x, int y)
+	void Game::CreateBoardCache()
 	{
-		int primalXPosition{ x };
-		POINT piecePosition{ x, y };
+		if (!SDL_RenderTargetSupported(renderer))
+		{
+			return;
+		}
 
-		for (size_t i{}; i < Figures[static_cast<int>(figure)][rotation].size(); i++)
+		boardCache = SDL_CreateTexture(
+			renderer,
+			SDL_PIXELFORMAT_RGBA8888,
+			SDL_TEXTUREACCESS_TARGET,
+			BOARD_CACHE_RECT.w,
+			BOARD_CACHE_RECT.h);
+
+		if (boardCache == NULL)
 		{
-			for (size_t j{}; j < Figures[static_cast<int>(figure)][rotation][i].size(); j++)
-			{
-				if (Figures[static_cast<int>(figure)][rotation][i][j] == 0)
-				{
-					piecePosition.x += BLOCK_SIZE;
-				}
-				else
-				{
-					DrawBlock(piecePosition, blockTexture);
-					piecePosition.x += BLOCK_SIZE;
-				}
-			}
+			throw TextureNullReference();
+		}
+
+		// Blending into the transparent cache leaves its colours premultiplied
+		// by alpha, so it has to be drawn with a premultiplied blend mode for
+		// the half transparent board background to look the same. Renderers
+		// without custom blend modes draw the background separately instead.
+		SDL_BlendMode premultipliedBlendMode
+		{
+			SDL_ComposeCustomBlendMode(
+				SDL_BLENDFACTOR_ONE,
+				SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+				SDL_BLENDOPERATION_ADD,
+				SDL_BLENDFACTOR_ONE,
+				SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+				SDL_BLENDOPERATION_ADD)
+		};
 
-			piecePosition.y += BLOCK_SIZE;
-			piecePosition.x = primalXPosition;
+		isBoardBackgroundCached = SDL_SetTextureBlendMode(boardCache, premultipliedBlendMode) == 0;
+
+		if (!isBoardBackgroundCached)
+		{
+			SDL_SetTextureBlendMode(boardCache, SDL_BLENDMODE_BLEND);
 		}
 	}
 
-	void Game::DrawBoard()
+	void Game::UpdateBoardCache()
 	{
-		SDL_RenderCopy(renderer, boardTexture, NULL, &BOARD_RECT);
-		int primalXPosition{ boardPosition.x };
-		POINT blockPosition{ boardPosition };
+		SDL_SetRenderTarget(renderer, boardCache);
+		SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+		SDL_RenderClear(renderer);
 
-		for (int i{}; i < BOARD_HEIGHT_IN_BLOCKS; i++)
+		if (isBoardBackgroundCached)
 		{
-			for (int j{}; j < BOARD_WIDTH_IN_BLOCKS; j++)
+			SDL_Rect boardRect
 			{
-				switch (board[i][j])
-				{
-				case 3:
-					break;
+				BOARD_RECT.x - BOARD_CACHE_RECT.x,
+				BOARD_RECT.y - BOARD_CACHE_RECT.y,
+				BOARD_RECT.w,
+				BOARD_RECT.h
+			};
 
-				case 2:
-					DrawBlock(blockPosition, blockTexture);
-					break;
+			SDL_RenderCopy(renderer, boardTexture, NULL, &boardRect);
+		}
 
-				default:
-					break;
-				}
+		DrawBoardBlocks({ 0, 0 });
+		blockBatch->Flush();
 
-				blockPosition.x += BLOCK_SIZE;
-			}
+		SDL_SetRenderTarget(renderer, NULL);
 
-			blockPosition.x = primalXPosition;
-			blockPosition.y += BLOCK_SIZE;
-		}
+		cachedBoardVersion = snapshot->boardVersion;
 	}
 
 	void Game::HandleMainMenuEvent(SDL_Event event)
@@ -335,6 +996,15 @@ namespace GameNamespace
 
 				if (menuButton->PressButton({ mouseCoordinateX, mouseCoordinateY }))
 				{
+					bot.reset();
+					InitializeGame();
+				}
+				else if (botButton->PressButton({ mouseCoordinateX, mouseCoordinateY }))
+				{
+					bot = std::make_unique<Bot>(
+						EvaluationWeights{},
+						std::chrono::microseconds{ BOT_THINKING_BUDGET_MICROSECONDS },
+						(int)std::thread::hardware_concurrency());
 					InitializeGame();
 				}
 				break;
@@ -362,31 +1032,39 @@ namespace GameNamespace
 			switch (event.key.keysym.sym)
 			{
 			case SDLK_a:
-				pieceMovement = PieceMovement::Left;
+				inputQueue.Push({ PieceMovement::Left, event.key.timestamp });
 				break;
 
 			case SDLK_LEFT:
-				pieceMovement = PieceMovement::Left;
+				inputQueue.Push({ PieceMovement::Left, event.key.timestamp });
 				break;
 
 			case SDLK_d:
-				pieceMovement = PieceMovement::Right;
+				inputQueue.Push({ PieceMovement::Right, event.key.timestamp });
 				break;
 
 			case SDLK_RIGHT:
-				pieceMovement = PieceMovement::Right;
+				inputQueue.Push({ PieceMovement::Right, event.key.timestamp });
 				break;
 
 			case SDLK_SPACE:
-				pieceMovement = PieceMovement::Rotation;
+				inputQueue.Push({ PieceMovement::Rotation, event.key.timestamp });
 				break;
 
 			case SDLK_s:
-				pieceMovement = PieceMovement::SpeedUp;
+				inputQueue.Push({ PieceMovement::SpeedUp, event.key.timestamp });
 				break;
 
 			case SDLK_DOWN:
-				pieceMovement = PieceMovement::SpeedUp;
+				inputQueue.Push({ PieceMovement::SpeedUp, event.key.timestamp });
+				break;
+
+			case SDLK_w:
+				inputQueue.Push({ PieceMovement::HardDrop, event.key.timestamp });
+				break;
+
+			case SDLK_UP:
+				inputQueue.Push({ PieceMovement::HardDrop, event.key.timestamp });
 				break;
 
 			case SDLK_ESCAPE:
@@ -419,6 +1097,7 @@ namespace GameNamespace
 				break;
 
 			case SDLK_ESCAPE:
+				SaveReplay();
 				gameState = GameState::MenuMode;
 				break;
 
@@ -461,370 +1140,110 @@ namespace GameNamespace
 		}
 	}
 
-	void Game::MovePiece()
-	{
-		PieceRotation pieceRotation{};
-
-		switch (pieceMovement)
-		{
-		case PieceMovement::Left:
-
-			if (CheckIsPieceCanMove(Direction::Left))
-			{
-				currentFigurePosition.x -= BLOCK_SIZE;
-			}
-			break;
-
-		case PieceMovement::Right:
-
-			if (CheckIsPieceCanMove(Direction::Right))
-			{
-				currentFigurePosition.x += BLOCK_SIZE;
-			}
-			break;
-
-		case PieceMovement::Rotation:
-
-			pieceRotation = CheckIsPieceCanRotate();
-
-			if (pieceRotation.pieceCanRotate)
-			{
-				currentFigurePosition.x += pieceRotation.pieceShift * BLOCK_SIZE;
-				rotation = pieceRotation.nextRotation;
-			}
-			break;
-
-		case PieceMovement::SpeedUp:
-
-			if (CheckIsPieceCanMove())
-			{
-				currentFigurePosition.y += BLOCK_SIZE;
-			}
-			else
-			{
-				GoToNextPiece();
-			}
-
-			pieceMovement = PieceMovement::None;
-
-			break;
-
-		case PieceMovement::None:
-
-			if (CheckIsPieceCanMove())
-			{
-				if (currentFrame == FPS)
-				{
-					currentFigurePosition.y += BLOCK_SIZE;
-				}
-			}
-			else
-			{
-				GoToNextPiece();
-			}
-
-			break;
-
-		default:
-			break;
-		}
-
-		pieceMovement = PieceMovement::None;
-	}
-
-	void Game::InitializeGame()
-	{
-		board = InitializeBoard();
-		currentFigure = (FigureKind)(rand() % PIECE_KINDS);
-		nextFigure = (FigureKind)(rand() % PIECE_KINDS);
-		rotation = rand() % PIECE_ROTATIONS;
-		nextRotation = rand() % PIECE_ROTATIONS;
-
-		currentFigurePosition = {
-				BOARD_POSITION_X + PIECE_INITIAL_SHIFT_X,
-				BOARD_POSITION_Y
-		};
-
-		score = 0;
-
-		gameState = GameState::Running;
-	}
-
-	void Game::GoToNextPiece()
-	{
-		if (currentFrame == FPS)
-		{
-			SaveCurrentPiece();
-
-			currentFigure = nextFigure;
-			nextFigure = (FigureKind)(rand() % PIECE_KINDS);
-			rotation = nextRotation;
-			nextRotation = rand() % PIECE_ROTATIONS;
-			currentFigurePosition = {
-				BOARD_POSITION_X + PIECE_INITIAL_SHIFT_X,
-				BOARD_POSITION_Y
-			};
-
-			DeleteLines();
-			CheckIsGameOver();
-		}
-	}
-
-	std::vector<std::vector<int>> Game::InitializeBoard()
-	{
-		std::vector<std::vector<int>> board(
-			BOARD_HEIGHT_IN_BLOCKS, std::vector<int>(BOARD_WIDTH_IN_BLOCKS));
-
-		for (int i{}; i < BOARD_HEIGHT_IN_BLOCKS; i++)
-		{
-			for (int j{}; j < BOARD_WIDTH_IN_BLOCKS; j++)
-			{
-				if (j == 0 || i == BOARD_HEIGHT_IN_BLOCKS - 1 || j == BOARD_WIDTH_IN_BLOCKS - 1)
-				{
-					board[i][j] = 3;
-				}
-				else
-				{
-					board[i][j] = 0;
-				}
-			}
-		}
-
-		return board;
-	}
-
-	bool Game::CheckIsPieceCanMove()
+	void Game::TickEngine()
 	{
-		int xIndex = (currentFigurePosition.x - BOARD_POSITION_X) / BLOCK_SIZE;
-		int yIndex = (currentFigurePosition.y - BOARD_POSITION_Y) / BLOCK_SIZE + 1;
+		std::array<PieceMovement, INPUT_QUEUE_CAPACITY> movements{};
+		InputEvent input{};
+		int count{};
 
-		for (int i{}; i < Figures[static_cast<int>(currentFigure)][rotation].size(); i++)
+		if (replayPlayer)
 		{
-			if (yIndex + i < 0)
-			{
-				continue;
-			}
-
-			for (int j{}; j < Figures[static_cast<int>(currentFigure)][rotation][i].size(); j++)
-			{
-				if (Figures[static_cast<int>(currentFigure)][rotation][i][j] != 0)
-				{
-					if (board[yIndex + i][xIndex + j] != 0)
-					{
-						return false;
-					}
-				}
-			}
+			inputQueue.Clear();
+			count = replayPlayer->ReadTick(movements.data(), INPUT_QUEUE_CAPACITY);
 		}
 
-		return true;
-	}
-
-	bool Game::CheckIsPieceCanMove(Direction direction)
-	{
-		int xIndex = (currentFigurePosition.x - BOARD_POSITION_X) / BLOCK_SIZE + (int)direction;
-		int yIndex = (currentFigurePosition.y - BOARD_POSITION_Y) / BLOCK_SIZE;
-
-		for (int i{}; i < Figures[static_cast<int>(currentFigure)][rotation].size(); i++)
+		while (inputQueue.Pop(input))
 		{
-			if (yIndex + i < 0)
-			{
-				continue;
-			}
-
-			for (int j{}; j < Figures[static_cast<int>(currentFigure)][rotation][i].size(); j++)
-			{
-				if (Figures[static_cast<int>(currentFigure)][rotation][i][j] != 0)
-				{
-					if (board[yIndex + i][xIndex + j] != 0)
-					{
-						return false;
-					}
-				}
-			}
+			movements[count++] = input.movement;
+			replayRecorder.Record(input.movement);
 		}
 
-		return true;
+		engine.Tick(movements.data(), count);
+		replayRecorder.EndTick();
 	}
 
-	PieceRotation Game::CheckIsPieceCanRotate()
+	void Game::SaveReplay()
 	{
- 		int xIndex{ (currentFigurePosition.x - BOARD_POSITION_X) / BLOCK_SIZE };
-		int yIndex{ (currentFigurePosition.y - BOARD_POSITION_Y) / BLOCK_SIZE };
-		int nextRotation{ CalculateNextRotation() };
-
-		PieceRotation pieceRotaion{};
-
- 		int leftShift
-		{ 
-			xIndex 
-			+ 
-			(int)Figures[static_cast<int>(currentFigure)][nextRotation][0].size() + 1
-			- 
-			(int)(BOARD_WIDTH / BLOCK_SIZE) 
-		};
-
-		if (leftShift < 0)
+		if (!replayRecorder.IsRecording())
 		{
-			leftShift = 0;
+			return;
 		}
 
-		xIndex -= leftShift;
+		replayRecorder.Finish(engine.GetScore(), engine.GetLockedPieces());
 
-		int rightShift{ 0 - xIndex + 1 };
+		std::error_code error{};
+		std::filesystem::create_directories(REPLAY_DIRECTORY_PATH, error);
 
-		if (rightShift < 0)
-		{
-			rightShift = 0;
-		}
+		std::string path{ REPLAY_DIRECTORY_PATH };
+		path.append("/");
+		path.append(std::to_string(engine.GetSeed()));
+		path.append(REPLAY_FILE_EXTENSION);
 
-		xIndex += rightShift;
-
-		for (int i{}; i < Figures[static_cast<int>(currentFigure)][nextRotation].size(); i++)
+		if (!replayRecorder.Save(path.c_str()))
 		{
-			if (yIndex + i < 0)
-			{
-				continue;
-			}
-
-			for (int j{}; j < Figures[static_cast<int>(currentFigure)][nextRotation][i].size(); j++)
-			{
-				if (Figures[static_cast<int>(currentFigure)][nextRotation][i][j] != 0)
-				{
-					if (board[yIndex + i][xIndex + j] != 0)
-					{
-						pieceRotaion.pieceCanRotate = false;
-						return pieceRotaion;
-					}
-				}
-			}
+			SDL_Log("Replay %s couldn't be saved", path.c_str());
 		}
-
-		pieceRotaion.pieceShift -= leftShift;
-		pieceRotaion.pieceShift += rightShift;
-
-		pieceRotaion.nextRotation = nextRotation;
-		pieceRotaion.pieceCanRotate = true;
-
-		return pieceRotaion;
 	}
 
-	int Game::CalculateNextRotation()
+	// The agent sees every tick the window shows and its movements join the
+	// keyboard's in the input queue. The game never waits for the agent:
+	// a tick without an answer is a tick without a movement. After a game
+	// over, any answer starts the next game.
+	void Game::UpdateBridge()
 	{
-		if (rotation < PIECE_ROTATIONS - 1)
-		{
-			return rotation + 1;
-		}
-		else
+		if (bridge->IsPeerClosed())
 		{
-			return 0;
+			SDL_Log("Bridge: the agent left after %lld games", bridgeGames);
+			bridge.reset();
+			return;
 		}
-	}
-
-	void Game::SaveCurrentPiece()
-	{
-		int xIndex = (currentFigurePosition.x - BOARD_POSITION_X) / BLOCK_SIZE;
-		int yIndex = (currentFigurePosition.y - BOARD_POSITION_Y) / BLOCK_SIZE;
-
-		for (int i{}; i < Figures[static_cast<int>(currentFigure)][rotation].size(); i++)
-		{
-			if (yIndex + i < 0)
-			{
-				continue;
-			}
 
-			for (int j{}; j < Figures[static_cast<int>(currentFigure)][rotation][i].size(); j++)
-			{
-				if (Figures[static_cast<int>(currentFigure)][rotation][i][j] != 0)
-				{
-					board[yIndex + i][xIndex + j] = 2;
-				}
-			}
-		}
-	}
+		bridge->PublishState(engine, bridgeGames);
 
-	void Game::DeleteLines()
-	{
-		bool isFullLine{ true };
+		BridgeAction action{};
+		PieceMovement movement{};
 
-		for (size_t i{ 1 }; i < board.capacity() - 1; i++)
+		while (bridge->TryReceiveAction(action))
 		{
-			for (size_t j{ 1 }; j < board[i].capacity() - 1; j++)
+			if (gameState == GameState::GameOver || action.movement == AGENT_BRIDGE_RESET)
 			{
-				if (board[i][j] == 0)
-				{
-					isFullLine = false;
-				}
+				SaveReplay();
+				bridgeGames++;
+				InitializeGame();
 			}
-
-			if (isFullLine)
+			else if (GetBridgeMovement(action, movement))
 			{
-				DropUpperBlocks(i);
-				AddScore();
+				inputQueue.Push({ movement, SDL_GetTicks() });
 			}
-
-			isFullLine = true;
 		}
 	}
 
-	void Game::DropUpperBlocks(int yIndex)
+	void Game::InitializeGame()
 	{
-		for (int i{ yIndex }; i > 1; i--)
-		{
-			for (size_t j{ 1 }; j < board[i].capacity() - 1; j++)
-			{
-				board[i][j] = board[i - 1][j];
-			}
-		}
+		engine.Reset(SDL_GetPerformanceCounter());
+		replayPlayer.reset();
+		replayRecorder.Begin(engine.GetSeed(), engine.GetRandomizerKind());
 
-		for (size_t j{ 1 }; j < board[0].capacity() - 1; j++)
-		{
-			board[0][j] = 0;
-		}
-	}
-
-	void Game::AddFrame()
-	{
-		if (currentFrame == FPS)
-		{
-			currentFrame = 0;
-		}
-		else
-		{
-			currentFrame++;
-		}
+		StartGame();
 	}
 
-	void Game::CheckIsGameOver()
+	void Game::StartGame()
 	{
-		int xIndex = (currentFigurePosition.x - BOARD_POSITION_X) / BLOCK_SIZE;
-		int yIndex = (currentFigurePosition.y - BOARD_POSITION_Y) / BLOCK_SIZE;
-
-		for (int i{}; i < Figures[static_cast<int>(currentFigure)][rotation].size(); i++)
-		{
-			if (yIndex + i < 0)
-			{
-				continue;
-			}
+		inputQueue.Clear();
+		gameOverTicks = 0;
+		previousPosition = engine.GetPosition();
+		previousLockedPieces = engine.GetLockedPieces();
 
-			for (int j{}; j < Figures[static_cast<int>(currentFigure)][rotation][i].size(); j++)
-			{
-				if (Figures[static_cast<int>(currentFigure)][rotation][i][j] != 0)
-				{
-					if (board[yIndex + i][xIndex + j] != 0)
-					{
-						gameState = GameState::GameOver;
-					}
-				}
-			}
-		}
+		gameState = GameState::Running;
 	}
 
 	void Game::DrawScene()
 	{
-		SDL_RenderCopy(renderer, infoBlockTexture, NULL, &INFO_BLOCK_RECT);
+		DrawTexture(infoBlockTexture, openGLInfoBlockTexture, &INFO_BLOCK_RECT);
 
-		int nextPieceWidth = (int)Figures[static_cast<int>(nextFigure)][nextRotation][0].size();
+		FigureKind nextFigure{ snapshot->nextFigure };
+		size_t nextRotation{ snapshot->nextRotation };
+		int nextPieceWidth = GetPieceLayout(nextFigure, nextRotation).width;
 		int nextPiecePositionX{ 
 			INFO_BLOCK_POSITION_X 
 			+ 
@@ -832,51 +1251,16 @@ namespace GameNamespace
 
 		DrawFigure(nextFigure, nextRotation, nextPiecePositionX, NEXT_PIECE_POSITION_Y);
 
-		int tempScore{ score };
+		int tempScore{ snapshot->score };
 
 		for (int i{ NUMBER_OF_SCORE_DIGITS - 1 }; i >= 0; i--)
 		{
-			CreateMessage
-			(
-				Font::Scene, 
-				std::to_string(tempScore % 10).c_str(), 
-				MAIN_FONT_COLOR,
-				SCORE_MESSAGE_RECTANGLES[i]
-			);
-
-			tempScore /= 10;
-		}
-	}
-
-	void Game::CreateMessage(
-		Font fontKind,
-		const char* text, 
-		SDL_Color color, 
-		SDL_Rect messageRectangle)
-	{
-		TTF_Font* font = GetFont(fontKind);
-
-		SDL_Surface* surface{
-			TTF_RenderText_Solid(font, text, color) 
-		};
-
-		if (surface == NULL)
-		{
-			throw SurfaceNullReference();
-		}
+			char digit[]{ (char)('0' + tempScore % 10), '\0' };
 
-		SDL_Texture* message{
-			SDL_CreateTextureFromSurface(renderer, surface)
-		};
+			textRenderer->DrawText(GetFont(Font::Scene), digit, MAIN_FONT_COLOR, SCORE_MESSAGE_RECTANGLES[i]);
 
-		if (message == NULL)
-		{
-			throw MessageNullReference();
+			tempScore /= 10;
 		}
-
-		SDL_RenderCopy(renderer, message, NULL, &messageRectangle);
-		SDL_FreeSurface(surface);
-		SDL_DestroyTexture(message);
 	}
 
 	TTF_Font* Game::GetFont(Font font)
@@ -896,31 +1280,21 @@ namespace GameNamespace
 
 	void Game::PrintGameOver()
 	{
-		SetColor(Color::transparentBlack);
-		SDL_RenderFillRect(renderer, &BACKGROUND_RECTANGLE);
-
-		CreateMessage(Font::GameOver, "GAME OVER!", MAIN_FONT_COLOR, GAME_OVER_MESSAGE_RECTANGLE);
-		CreateMessage(Font::Scene, "Press Enter to start again", MAIN_FONT_COLOR, START_AGAIN_MESSAGE_RECTANGLE);
-	}
+		DrawOverlay();
 
-	void Game::AddScore()
-	{
-		if (score + SCORE_ADDITION <= SCORE_MAX_VALUE)
-		{
-			score += SCORE_ADDITION;
-		}
+		textRenderer->DrawStaticText(gameOverMessage, GAME_OVER_MESSAGE_RECTANGLE);
+		textRenderer->DrawStaticText(startAgainMessage, START_AGAIN_MESSAGE_RECTANGLE);
 	}
 
 	void Game::PrintPauseGame()
 	{
-		SetColor(Color::transparentBlack);
-		SDL_RenderFillRect(renderer, &BACKGROUND_RECTANGLE);
+		DrawOverlay();
 
-		CreateMessage(Font::GameOver, "GAME PAUSED", MAIN_FONT_COLOR, GAME_OVER_MESSAGE_RECTANGLE);
-		CreateMessage(Font::Scene, "Press Enter or Escape to resume game", MAIN_FONT_COLOR, START_AGAIN_MESSAGE_RECTANGLE);
+		textRenderer->DrawStaticText(gamePausedMessage, GAME_OVER_MESSAGE_RECTANGLE);
+		textRenderer->DrawStaticText(resumeGameMessage, START_AGAIN_MESSAGE_RECTANGLE);
 	}
 
-	SDL_Texture* Game::LoadTexture(const char* textureFilePath)
+	SDL_Surface* Game::LoadSurface(const char* textureFilePath)
 	{
 		SDL_Surface* surface
 		{
@@ -932,6 +1306,13 @@ namespace GameNamespace
 			throw SurfaceNullReference();
 		}
 
+		return surface;
+	}
+
+	SDL_Texture* Game::LoadTexture(const char* textureFilePath)
+	{
+		SDL_Surface* surface{ LoadSurface(textureFilePath) };
+
 		SDL_Texture* texture
 		{ 
 			SDL_CreateTextureFromSurface(renderer, surface) 
@@ -946,4 +1327,14 @@ namespace GameNamespace
 
 		return texture;
 	}
+
+	size_t Game::LoadOpenGLTexture(const char* textureFilePath)
+	{
+		SDL_Surface* surface{ LoadSurface(textureFilePath) };
+		size_t texture{ openGL->AddTexture(surface) };
+
+		SDL_FreeSurface(surface);
+
+		return texture;
+	}
 }
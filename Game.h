@@ -6,21 +6,54 @@
 #include <SDL_main.h>
 #include <vector>
 #include "Button.h"
+#include "Engine.h"
+#include "TextRenderer.h"
+#include "InputQueue.h"
+#include "Replay.h"
+#include "Bot.h"
+#include "AgentBridge.h"
+#include "BlockBatch.h"
+#include "OpenGLRenderer.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "FramePacer.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace GameNamespace
 {
+	// How the game draws. framesPerSecond 0 follows the display.
+	struct RenderOptions
+	{
+		RenderBackend backend{ RenderBackend::SDLRenderer };
+		bool isVSync{};
+		int framesPerSecond{};
+	};
+
 	class Game
 	{
 	public:
-		Game();
+		Game(const RenderOptions& options = {});
 		~Game();
 
 		void HandleEvents();
-		void Render();
+		// Sleeps until an event arrives or the timeout passes and handles
+		// what came in. Returns whether anything did.
+		bool WaitForEvents(int timeoutMilliseconds);
 		void Update();
+		void PublishSnapshot(double interpolation);
+		// Draws and paces a frame on the calling thread when the game has no
+		// render thread and a frame is due. Returns whether it drew one.
+		bool RenderFrame();
 		bool IsRunning();
-		int GetFrameDelay();
+		bool IsIdle() const;
+		void StartReplay(const char* replayFilePath);
+		void StartBridge(const char* bridgeName);
+		int GetRefreshRate();
 
 	private:
 		SDL_Renderer* renderer{};
@@ -31,65 +64,106 @@ namespace GameNamespace
 		SDL_Texture* backgroundTexture{};
 		SDL_Texture* boardTexture{};
 		SDL_Texture* infoBlockTexture{};
-		std::vector<std::vector<int>> board{};
-		FigureKind currentFigure{};
-		FigureKind nextFigure{};
-		size_t rotation{};
-		size_t nextRotation{};
-		POINT currentFigurePosition
-		{
-			BOARD_POSITION_X + PIECE_INITIAL_SHIFT_X,
-			BOARD_POSITION_Y
-		};
+		SDL_Texture* boardCache{};
+		std::unique_ptr<OpenGLRenderer> openGL{};
+		size_t openGLBlockTexture{};
+		size_t openGLBackgroundTexture{};
+		size_t openGLBoardTexture{};
+		size_t openGLInfoBlockTexture{};
+		bool isBoardBackgroundCached{};
+		long long cachedBoardVersion{ -1 };
+		Engine engine{};
+		PiecePosition previousPosition{};
+		long long previousLockedPieces{};
+		double interpolation{};
+
+		// Frames are drawn from snapshots the logic thread publishes. With
+		// OpenGL a render thread draws them, the context handed to it with
+		// MakeCurrent. SDL's 2D renderer has to stay on the thread that made
+		// the window, so with it the main loop draws them between ticks.
+		TripleBuffer<RenderSnapshot> snapshots{};
+		const RenderSnapshot* snapshot{};
+		std::thread renderThread{};
+		std::atomic<bool> isRendering{};
+		std::atomic<bool> isBoardCacheLost{};
+		std::exception_ptr renderException{};
+		std::unique_ptr<FramePacer> framePacer{};
+		std::atomic<bool> isPacingOverlayVisible{};
+		std::atomic<bool> isWindowVisible{ true };
+		std::atomic<bool> isRedrawRequested{};
+		bool isFramePacerIdle{ true };
+		std::mutex redrawMutex{};
+		std::condition_variable redrawReady{};
+		std::atomic<bool> hasRenderFailed{};
+		long long presentedFrames{};
+		long long idleWaits{};
+		Uint64 totalSnapshotAge{};
+		Uint64 longestSnapshotAge{};
 		POINT boardPosition
 		{
 			BOARD_POSITION_X,
 			BOARD_POSITION_Y
 		};
 		std::unique_ptr<Button> menuButton{};
+		std::unique_ptr<Button> botButton{};
+		std::unique_ptr<TextRenderer> textRenderer{};
+		std::unique_ptr<BlockBatch> blockBatch{};
+		size_t gameOverMessage{};
+		size_t startAgainMessage{};
+		size_t gamePausedMessage{};
+		size_t resumeGameMessage{};
 
 		GameState gameState{ GameState::MenuMode };
 
-		PieceMovement pieceMovement{ PieceMovement::None };
-
-		int currentFrame{};
-		int score{};
+		InputQueue inputQueue{};
+		ReplayRecorder replayRecorder{};
+		std::unique_ptr<ReplayPlayer> replayPlayer{};
+		std::unique_ptr<Bot> bot{};
+		int gameOverTicks{};
+		std::unique_ptr<AgentBridge> bridge{};
+		long long bridgeGames{};
 
+		void HandleEvent(SDL_Event event);
 		void HandleMainMenuEvent(SDL_Event event);
 		void HandleGameEvent(SDL_Event event);
 		void HandleGamePausedEvent(SDL_Event event);
 		void HandleGameOverEvent(SDL_Event event);
 
-		void MovePiece();
+		void StartRenderThread();
+		void StopRenderThread();
+		void RunRenderThread();
+		void RequestRedraw();
+		bool ShouldRender() const;
+		bool DrawFrame();
+		void Render();
+
 		void InitializeGame();
-		void GoToNextPiece();
+		void StartGame();
+		void TickEngine();
+		void SaveReplay();
+		void UpdateBridge();
 
-		std::vector<std::vector<int>> InitializeBoard();
-		bool CheckIsPieceCanMove();
-		bool CheckIsPieceCanMove(Direction direction);
-		PieceRotation CheckIsPieceCanRotate();
-		void CheckIsGameOver();
-		int CalculateNextRotation();
-		void AddFrame();
-		void DeleteLines();
-		void DropUpperBlocks(int yIndex);
-		void SaveCurrentPiece();
 		void DrawFigure();
-		void DrawFigure(FigureKind figure, size_t rotation, int x, int y);
+		void DrawFigure(FigureKind figure, size_t rotation, int x, int y, Uint8 alpha = SDL_ALPHA_OPAQUE);
 		void DrawBoard();
+		void DrawBoardBlocks(POINT position);
+		void CreateBoardCache();
+		void UpdateBoardCache();
 		void DrawScene();
 		void DrawBlock(POINT point, Color color);
-		void DrawBlock(POINT point, SDL_Texture* texture);
+		void DrawBlock(int x, int y, Uint8 alpha = SDL_ALPHA_OPAQUE);
+		void DrawTexture(SDL_Texture* texture, size_t openGLTexture, const SDL_Rect* rectangle,
+			Uint8 alpha = SDL_ALPHA_OPAQUE);
+		void FillRectangle(const SDL_Rect* rectangle, SDL_Color color);
+		void FlushBlocks();
+		void DrawOverlay();
+		void DrawPacingOverlay();
 		void SetColor(Color color);
-		void CreateMessage(
-			Font fontKind,
-			const char* text,
-			SDL_Color color,
-			SDL_Rect messageRectangle);
 		TTF_Font* GetFont(Font font);
 		void PrintGameOver();
-		void AddScore();
 		void PrintPauseGame();
+		SDL_Surface* LoadSurface(const char* textureFilePath);
 		SDL_Texture* LoadTexture(const char* textureFilePath);
+		size_t LoadOpenGLTexture(const char* textureFilePath);
 	};
 }
@@ -54,3 +54,21 @@ struct SetTextureAlphaModException : public std::exception {
 		return "SDL_SetTextureAlphaMod failed";
 	}
 };
+
+struct ReplayLoadException : public std::exception {
+	const char* what() const throw () {
+		return "Replay file couldn`t be loaded";
+	}
+};
+
+struct BridgeHostException : public std::exception {
+	const char* what() const throw () {
+		return "Agent bridge couldn`t be created";
+	}
+};
+
+struct OpenGLInitException : public std::exception {
+	const char* what() const throw () {
+		return "OpenGL renderer hasn`t been created";
+	}
+};
@@ -0,0 +1,50 @@
+#include "InputQueue.h"
+
+namespace GameNamespace
+{
+	bool InputQueue::Push(InputEvent input)
+	{
+		pushedCount++;
+
+		if (size == INPUT_QUEUE_CAPACITY)
+		{
+			droppedCount++;
+			return false;
+		}
+
+		inputs[(head + size) % INPUT_QUEUE_CAPACITY] = input;
+		size++;
+
+		return true;
+	}
+
+	bool InputQueue::Pop(InputEvent& input)
+	{
+		if (size == 0)
+		{
+			return false;
+		}
+
+		input = inputs[head];
+		head = (head + 1) % INPUT_QUEUE_CAPACITY;
+		size--;
+
+		return true;
+	}
+
+	void InputQueue::Clear()
+	{
+		head = 0;
+		size = 0;
+	}
+
+	long long InputQueue::GetPushedCount() const
+	{
+		return pushedCount;
+	}
+
+	long long InputQueue::GetDroppedCount() const
+	{
+		return droppedCount;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "EngineConstants.h"
+#include <array>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	const int INPUT_QUEUE_CAPACITY{ 64 };
+
+	struct InputEvent
+	{
+		PieceMovement movement{};
+		uint32_t timestamp{};
+	};
+
+	// Fixed size ring buffer of player actions in the order they arrived.
+	// Pushing into a full queue drops the action and counts it.
+	class InputQueue
+	{
+	public:
+		bool Push(InputEvent input);
+		bool Pop(InputEvent& input);
+		void Clear();
+		long long GetPushedCount() const;
+		long long GetDroppedCount() const;
+
+	private:
+		std::array<InputEvent, INPUT_QUEUE_CAPACITY> inputs{};
+		int head{};
+		int size{};
+		long long pushedCount{};
+		long long droppedCount{};
+	};
+}
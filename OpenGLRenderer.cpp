@@ -0,0 +1,459 @@
+#include "OpenGLRenderer.h"
+#include "GameExceptions.h"
+#include <cstddef>
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const char* const VERTEX_SHADER
+		{
+			"#version 330 core\n"
+			"layout(location = 0) in vec4 target;\n"
+			"layout(location = 1) in vec4 source;\n"
+			"layout(location = 2) in vec4 color;\n"
+			"uniform vec2 screenSize;\n"
+			"out vec2 textureCoordinate;\n"
+			"out vec4 tint;\n"
+			"void main()\n"
+			"{\n"
+			"    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+			"    vec2 position = (target.xy + corner * target.zw) / screenSize;\n"
+			"    textureCoordinate = source.xy + corner * source.zw;\n"
+			"    tint = color;\n"
+			"    gl_Position = vec4(position.x * 2.0 - 1.0, 1.0 - position.y * 2.0, 0.0, 1.0);\n"
+			"}\n"
+		};
+
+		const char* const FRAGMENT_SHADER
+		{
+			"#version 330 core\n"
+			"in vec2 textureCoordinate;\n"
+			"in vec4 tint;\n"
+			"uniform sampler2D image;\n"
+			"out vec4 fragmentColor;\n"
+			"void main()\n"
+			"{\n"
+			"    fragmentColor = texture(image, textureCoordinate) * tint;\n"
+			"}\n"
+		};
+
+		const size_t WHITE_TEXTURE{ 0 };
+
+		GLuint CompileShader(GLenum type, const char* source)
+		{
+			GLuint shader{ glCreateShader(type) };
+			GLint isCompiled{};
+
+			glShaderSource(shader, 1, &source, NULL);
+			glCompileShader(shader);
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+
+			if (!isCompiled)
+			{
+				char log[512]{};
+
+				glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+				glDeleteShader(shader);
+				SDL_SetError("%s", log);
+
+				throw OpenGLInitException();
+			}
+
+			return shader;
+		}
+	}
+
+	OpenGLRenderer::OpenGLRenderer(SDL_Window* window, int width, int height, bool isVSync)
+	{
+		this->window = window;
+		this->width = width;
+		this->height = height;
+
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+
+		context = SDL_GL_CreateContext(window);
+
+		if (context == NULL)
+		{
+			throw OpenGLInitException();
+		}
+
+		if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress) || !GLAD_GL_VERSION_3_3)
+		{
+			SDL_GL_DeleteContext(context);
+			SDL_SetError("OpenGL 3.3 is not available");
+
+			throw OpenGLInitException();
+		}
+
+		SDL_GL_SetSwapInterval(isVSync ? 1 : 0);
+
+		// The destructor does not run when the constructor throws.
+		try
+		{
+			CreateProgram();
+			CreateInstanceBuffer();
+
+			glEnable(GL_BLEND);
+			glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+			SDL_Surface* white{ SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32) };
+
+			if (white == NULL)
+			{
+				throw SurfaceNullReference();
+			}
+
+			SDL_FillRect(white, NULL, SDL_MapRGBA(white->format, 255, 255, 255, 255));
+
+			try
+			{
+				AddTexture(white);
+			}
+			catch (...)
+			{
+				SDL_FreeSurface(white);
+				throw;
+			}
+
+			SDL_FreeSurface(white);
+		}
+		catch (...)
+		{
+			Release();
+			throw;
+		}
+	}
+
+	OpenGLRenderer::~OpenGLRenderer()
+	{
+		Release();
+	}
+
+	void OpenGLRenderer::Release()
+	{
+		for (GLsync fence : fences)
+		{
+			if (fence != NULL)
+			{
+				glDeleteSync(fence);
+			}
+		}
+
+		for (const Texture& texture : textures)
+		{
+			glDeleteTextures(1, &texture.name);
+		}
+
+		if (isBufferPersistent)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+
+		glDeleteBuffers(1, &instanceBuffer);
+		glDeleteVertexArrays(1, &vertexArray);
+		glDeleteProgram(program);
+		SDL_GL_DeleteContext(context);
+	}
+
+	void OpenGLRenderer::MakeCurrent(bool isCurrent)
+	{
+		SDL_GL_MakeCurrent(window, isCurrent ? context : NULL);
+	}
+
+	size_t OpenGLRenderer::AddTexture(SDL_Surface* surface)
+	{
+		SDL_Surface* pixels{ SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0) };
+
+		if (pixels == NULL)
+		{
+			throw SurfaceNullReference();
+		}
+
+		Texture texture{ 0, pixels->w, pixels->h };
+
+		glGenTextures(1, &texture.name);
+		glBindTexture(GL_TEXTURE_2D, texture.name);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, pixels->pitch / 4);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, pixels->w, pixels->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels->pixels);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+		SDL_FreeSurface(pixels);
+
+		if (texture.name == 0)
+		{
+			throw TextureNullReference();
+		}
+
+		textures.push_back(texture);
+
+		return textures.size() - 1;
+	}
+
+	void OpenGLRenderer::Clear()
+	{
+		runs.clear();
+		instanceCount = 0;
+
+		if (isBufferPersistent)
+		{
+			// Waits until the GPU is done with the part written three frames
+			// ago, which it almost always is.
+			if (fences[bufferFrame] != NULL)
+			{
+				glClientWaitSync(fences[bufferFrame], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+				glDeleteSync(fences[bufferFrame]);
+				fences[bufferFrame] = NULL;
+			}
+
+			instances = mappedInstances + (size_t)bufferFrame * OPENGL_INSTANCE_CAPACITY;
+		}
+
+		int drawableWidth{}, drawableHeight{};
+
+		SDL_GL_GetDrawableSize(window, &drawableWidth, &drawableHeight);
+		glViewport(0, 0, drawableWidth, drawableHeight);
+		glClearColor(0, 0, 0, 1);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	void OpenGLRenderer::Draw(size_t texture, const SDL_Rect* source, const SDL_Rect* target, SDL_Color color)
+	{
+		if (instanceCount == OPENGL_INSTANCE_CAPACITY)
+		{
+			droppedInstances++;
+			return;
+		}
+
+		const Texture& image{ textures[texture] };
+		OpenGLInstance& instance{ instances[instanceCount] };
+
+		if (target == NULL)
+		{
+			instance.target[0] = 0;
+			instance.target[1] = 0;
+			instance.target[2] = (float)width;
+			instance.target[3] = (float)height;
+		}
+		else
+		{
+			instance.target[0] = (float)target->x;
+			instance.target[1] = (float)target->y;
+			instance.target[2] = (float)target->w;
+			instance.target[3] = (float)target->h;
+		}
+
+		if (source == NULL)
+		{
+			instance.source[0] = 0;
+			instance.source[1] = 0;
+			instance.source[2] = 1;
+			instance.source[3] = 1;
+		}
+		else
+		{
+			instance.source[0] = (float)source->x / image.width;
+			instance.source[1] = (float)source->y / image.height;
+			instance.source[2] = (float)source->w / image.width;
+			instance.source[3] = (float)source->h / image.height;
+		}
+
+		instance.color[0] = color.r;
+		instance.color[1] = color.g;
+		instance.color[2] = color.b;
+		instance.color[3] = color.a;
+
+		if (runs.empty() || runs.back().texture != texture)
+		{
+			runs.push_back({ texture, instanceCount, 0 });
+		}
+
+		runs.back().count++;
+		instanceCount++;
+	}
+
+	void OpenGLRenderer::FillRect(const SDL_Rect* target, SDL_Color color)
+	{
+		Draw(WHITE_TEXTURE, NULL, target, color);
+	}
+
+	void OpenGLRenderer::Present()
+	{
+		size_t bufferOffset{};
+
+		glUseProgram(program);
+		glUniform2f(screenSizeLocation, (float)width, (float)height);
+		glBindVertexArray(vertexArray);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+		glActiveTexture(GL_TEXTURE0);
+
+		if (isBufferPersistent)
+		{
+			bufferOffset = (size_t)bufferFrame * OPENGL_INSTANCE_CAPACITY * sizeof(OpenGLInstance);
+		}
+		else
+		{
+			glBufferData(GL_ARRAY_BUFFER, OPENGL_INSTANCE_CAPACITY * sizeof(OpenGLInstance), NULL, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * sizeof(OpenGLInstance), instances);
+		}
+
+		for (const Run& run : runs)
+		{
+			glBindTexture(GL_TEXTURE_2D, textures[run.texture].name);
+			PointAttributes(bufferOffset + run.first * sizeof(OpenGLInstance));
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, run.count);
+		}
+
+		if (isBufferPersistent)
+		{
+			fences[bufferFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			bufferFrame = (bufferFrame + 1) % OPENGL_BUFFER_FRAMES;
+		}
+
+		SDL_GL_SwapWindow(window);
+
+		lastDrawCalls = (int)runs.size();
+		lastInstances = instanceCount;
+		totalDrawCalls += lastDrawCalls;
+		totalInstances += lastInstances;
+		frames++;
+	}
+
+	int OpenGLRenderer::GetFrameDrawCalls() const
+	{
+		return lastDrawCalls;
+	}
+
+	int OpenGLRenderer::GetFrameInstances() const
+	{
+		return lastInstances;
+	}
+
+	long long OpenGLRenderer::GetFrames() const
+	{
+		return frames;
+	}
+
+	long long OpenGLRenderer::GetDrawCalls() const
+	{
+		return totalDrawCalls;
+	}
+
+	long long OpenGLRenderer::GetInstances() const
+	{
+		return totalInstances;
+	}
+
+	long long OpenGLRenderer::GetDroppedInstances() const
+	{
+		return droppedInstances;
+	}
+
+	bool OpenGLRenderer::IsBufferPersistent() const
+	{
+		return isBufferPersistent;
+	}
+
+	void OpenGLRenderer::CreateProgram()
+	{
+		GLuint vertexShader{ CompileShader(GL_VERTEX_SHADER, VERTEX_SHADER) };
+		GLuint fragmentShader{};
+		GLint isLinked{};
+
+		try
+		{
+			fragmentShader = CompileShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+		}
+		catch (...)
+		{
+			glDeleteShader(vertexShader);
+			throw;
+		}
+
+		program = glCreateProgram();
+		glAttachShader(program, vertexShader);
+		glAttachShader(program, fragmentShader);
+		glLinkProgram(program);
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+
+		if (!isLinked)
+		{
+			char log[512]{};
+
+			glGetProgramInfoLog(program, sizeof(log), NULL, log);
+			glDeleteProgram(program);
+			program = 0;
+			SDL_SetError("%s", log);
+
+			throw OpenGLInitException();
+		}
+
+		screenSizeLocation = glGetUniformLocation(program, "screenSize");
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "image"), 0);
+	}
+
+	void OpenGLRenderer::CreateInstanceBuffer()
+	{
+		glGenVertexArrays(1, &vertexArray);
+		glBindVertexArray(vertexArray);
+		glGenBuffers(1, &instanceBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+		for (GLuint attribute{}; attribute < 3; attribute++)
+		{
+			glEnableVertexAttribArray(attribute);
+			glVertexAttribDivisor(attribute, 1);
+		}
+
+		if (GLAD_GL_ARB_buffer_storage)
+		{
+			GLbitfield flags{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+			GLsizeiptr size{ (GLsizeiptr)OPENGL_BUFFER_FRAMES * OPENGL_INSTANCE_CAPACITY * sizeof(OpenGLInstance) };
+
+			glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+			mappedInstances = static_cast<OpenGLInstance*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+			isBufferPersistent = mappedInstances != NULL;
+		}
+
+		if (!isBufferPersistent)
+		{
+			// A buffer made by glBufferStorage cannot be resized, so the
+			// fallback needs a new one.
+			glDeleteBuffers(1, &instanceBuffer);
+			glGenBuffers(1, &instanceBuffer);
+			glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+			stagedInstances.resize(OPENGL_INSTANCE_CAPACITY);
+			instances = stagedInstances.data();
+		}
+		else
+		{
+			instances = mappedInstances;
+		}
+	}
+
+	void OpenGLRenderer::PointAttributes(size_t offset)
+	{
+		GLsizei stride{ sizeof(OpenGLInstance) };
+
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride,
+			reinterpret_cast<const void*>(offset + offsetof(OpenGLInstance, target)));
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride,
+			reinterpret_cast<const void*>(offset + offsetof(OpenGLInstance, source)));
+		glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+			reinterpret_cast<const void*>(offset + offsetof(OpenGLInstance, color)));
+	}
+}
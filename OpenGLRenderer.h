@@ -0,0 +1,109 @@
+#pragma once
+#include <glad/glad.h>
+#include <SDL.h>
+#include <vector>
+
+namespace GameNamespace
+{
+	const int
+		OPENGL_INSTANCE_CAPACITY{ 4096 },
+		OPENGL_BUFFER_FRAMES{ 3 };
+
+	// One textured, tinted rectangle. target is in window pixels, source in
+	// texture coordinates, color multiplies the texture.
+	struct OpenGLInstance
+	{
+		float target[4];
+		float source[4];
+		Uint8 color[4];
+	};
+
+	// Draws the game with OpenGL 3.3 core instead of SDL_Renderer. Every
+	// Draw and FillRect only appends an instance to the buffer of the frame;
+	// Present issues one instanced draw per run of instances sharing a
+	// texture and swaps the window.
+	//
+	// Where ARB_buffer_storage is available the instance buffer is mapped
+	// once, persistently, and split into OPENGL_BUFFER_FRAMES parts used in
+	// turn, each guarded by a fence, so instances are written straight into
+	// the memory the GPU reads. Elsewhere they are kept in memory and
+	// uploaded into an orphaned buffer when the frame is presented.
+	//
+	// The window has to be created with SDL_WINDOW_OPENGL.
+	class OpenGLRenderer
+	{
+	public:
+		OpenGLRenderer(SDL_Window* window, int width, int height, bool isVSync);
+		~OpenGLRenderer();
+
+		OpenGLRenderer(const OpenGLRenderer&) = delete;
+		OpenGLRenderer& operator=(const OpenGLRenderer&) = delete;
+
+		// Binds the context to the calling thread, or unbinds it, so another
+		// thread can take over drawing.
+		void MakeCurrent(bool isCurrent);
+		size_t AddTexture(SDL_Surface* surface);
+
+		void Clear();
+		void Draw(size_t texture, const SDL_Rect* source, const SDL_Rect* target, SDL_Color color);
+		void FillRect(const SDL_Rect* target, SDL_Color color);
+		void Present();
+
+		// Counters of the last presented frame.
+		int GetFrameDrawCalls() const;
+		int GetFrameInstances() const;
+
+		long long GetFrames() const;
+		long long GetDrawCalls() const;
+		long long GetInstances() const;
+		long long GetDroppedInstances() const;
+		bool IsBufferPersistent() const;
+
+	private:
+		struct Texture
+		{
+			GLuint name;
+			int width;
+			int height;
+		};
+
+		struct Run
+		{
+			size_t texture;
+			int first;
+			int count;
+		};
+
+		SDL_Window* window{};
+		SDL_GLContext context{};
+		int width{};
+		int height{};
+		GLuint program{};
+		GLint screenSizeLocation{};
+		GLuint vertexArray{};
+		GLuint instanceBuffer{};
+		std::vector<Texture> textures{};
+		std::vector<Run> runs{};
+
+		bool isBufferPersistent{};
+		OpenGLInstance* mappedInstances{};
+		GLsync fences[OPENGL_BUFFER_FRAMES]{};
+		int bufferFrame{};
+		std::vector<OpenGLInstance> stagedInstances{};
+		OpenGLInstance* instances{};
+		int instanceCount{};
+
+		int lastDrawCalls{};
+		int lastInstances{};
+		long long frames{};
+		long long totalDrawCalls{};
+		long long totalInstances{};
+		long long droppedInstances{};
+
+		// Deletes everything made so far, the context last.
+		void Release();
+		void CreateProgram();
+		void CreateInstanceBuffer();
+		void PointAttributes(size_t offset);
+	};
+}
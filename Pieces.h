@@ -0,0 +1,139 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	const int
+		PIECE_KINDS{ 7 },
+		PIECE_ROTATIONS{ 4 },
+		PIECE_CELLS{ 4 },
+		MAX_PIECE_SIZE{ 4 };
+
+	enum class FigureKind
+	{
+		Square = 0,
+		I = 1,
+		L = 2,
+		J = 3,
+		N = 4,
+		N_mirrored = 5,
+		T = 6
+	};
+
+	typedef std::array<std::array<int, MAX_PIECE_SIZE>, MAX_PIECE_SIZE> PieceCells;
+
+	struct PieceShape
+	{
+		int width{};
+		int height{};
+		PieceCells cells{};
+	};
+
+	struct CellOffset
+	{
+		int x{};
+		int y{};
+	};
+
+	// One rotation of a piece. width and height are the size of the shape's
+	// grid (which may have empty rows or columns), left/right/top/bottom the
+	// inclusive bounds of its occupied cells. Bit j of rowMasks[i] is cell (j, i).
+	struct PieceLayout
+	{
+		int width{};
+		int height{};
+		int left{};
+		int right{};
+		int top{};
+		int bottom{};
+		std::array<uint16_t, MAX_PIECE_SIZE> rowMasks{};
+		std::array<CellOffset, PIECE_CELLS> cells{};
+	};
+
+	typedef std::array<std::array<PieceLayout, PIECE_ROTATIONS>, PIECE_KINDS> PieceLayoutTable;
+
+	// Rotation 0 of every piece; the others are produced by turning it
+	// clockwise.
+	constexpr PieceShape BASE_PIECE_SHAPES[PIECE_KINDS]
+	{
+		{ 2, 2, {{ {1, 1}, {1, 1} }} },
+		{ 3, 4, {{ {0, 1, 0}, {0, 1, 0}, {0, 1, 0}, {0, 1, 0} }} },
+		{ 2, 3, {{ {1, 0}, {1, 0}, {1, 1} }} },
+		{ 2, 3, {{ {0, 1}, {0, 1}, {1, 1} }} },
+		{ 3, 2, {{ {1, 1, 0}, {0, 1, 1} }} },
+		{ 3, 2, {{ {0, 1, 1}, {1, 1, 0} }} },
+		{ 3, 2, {{ {0, 1, 0}, {1, 1, 1} }} }
+	};
+
+	constexpr PieceShape RotateClockwise(const PieceShape& shape)
+	{
+		PieceShape rotated{ shape.height, shape.width };
+
+		for (int i{}; i < rotated.height; i++)
+		{
+			for (int j{}; j < rotated.width; j++)
+			{
+				rotated.cells[i][j] = shape.cells[shape.height - 1 - j][i];
+			}
+		}
+
+		return rotated;
+	}
+
+	constexpr PieceLayout BuildPieceLayout(const PieceShape& shape)
+	{
+		PieceLayout layout{ shape.width, shape.height, shape.width, -1, shape.height, -1 };
+		int cell{};
+
+		for (int i{}; i < shape.height; i++)
+		{
+			for (int j{}; j < shape.width; j++)
+			{
+				if (shape.cells[i][j] == 0)
+				{
+					continue;
+				}
+
+				layout.rowMasks[i] |= (uint16_t)(1 << j);
+				layout.cells[cell++] = { j, i };
+				layout.left = j < layout.left ? j : layout.left;
+				layout.right = j > layout.right ? j : layout.right;
+				layout.top = i < layout.top ? i : layout.top;
+				layout.bottom = i > layout.bottom ? i : layout.bottom;
+			}
+		}
+
+		return layout;
+	}
+
+	constexpr PieceLayoutTable BuildPieceLayouts()
+	{
+		PieceLayoutTable table{};
+
+		for (int kind{}; kind < PIECE_KINDS; kind++)
+		{
+			PieceShape shape{ BASE_PIECE_SHAPES[kind] };
+
+			for (int rotation{}; rotation < PIECE_ROTATIONS; rotation++)
+			{
+				table[kind][rotation] = BuildPieceLayout(shape);
+				shape = RotateClockwise(shape);
+			}
+		}
+
+		return table;
+	}
+
+	constexpr PieceLayoutTable PIECE_LAYOUTS{ BuildPieceLayouts() };
+
+	constexpr const PieceLayout& GetPieceLayout(FigureKind figure, size_t rotation)
+	{
+		return PIECE_LAYOUTS[static_cast<int>(figure)][rotation];
+	}
+
+	static_assert(GetPieceLayout(FigureKind::I, 1).rowMasks[1] == 0b1111, "I piece turns horizontal");
+	static_assert(GetPieceLayout(FigureKind::L, 1).width == 3, "L piece turns on its side");
+	static_assert(GetPieceLayout(FigureKind::T, 2).rowMasks[0] == 0b111, "T piece turns upside down");
+}
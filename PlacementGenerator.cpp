@@ -0,0 +1,381 @@
+#include "PlacementGenerator.h"
+
+namespace GameNamespace
+{
+	namespace
+	{
+		// A position row has bit x - MIN_PIECE_X set for every column x a
+		// piece can be placed at.
+		typedef uint16_t PositionRow;
+
+		const PositionRow
+			ALL_POSITIONS_MASK{ (1 << PIECE_X_POSITIONS) - 1 },
+			OUTSIDE_BOARD_MASK{ (PositionRow)~ALL_POSITIONS_MASK };
+
+		// Turning a piece next to a wall pushes it back inside, so every
+		// position in a shift's from mask ends up at position to.
+		struct RotationShift
+		{
+			PositionRow from{};
+			int to{};
+		};
+
+		struct RotatedPositions
+		{
+			PositionRow unshifted{};
+			int shiftCount{};
+			std::array<RotationShift, PIECE_X_POSITIONS> shifts{};
+		};
+
+		typedef std::array<std::array<RotatedPositions, PIECE_ROTATIONS>, PIECE_KINDS> RotatedPositionTable;
+
+		RotatedPositionTable BuildRotatedPositions()
+		{
+			RotatedPositionTable table{};
+
+			for (int kind{}; kind < PIECE_KINDS; kind++)
+			{
+				for (int rotation{}; rotation < PIECE_ROTATIONS; rotation++)
+				{
+					RotatedPositions& positions{ table[kind][rotation] };
+
+					for (int x{ MIN_PIECE_X }; x < BOARD_WIDTH_IN_BLOCKS; x++)
+					{
+						int rotatedX{ Engine::CalculateRotatedX((FigureKind)kind, rotation, x) };
+						int shift{};
+
+						if (rotatedX == x)
+						{
+							positions.unshifted |= 1 << (x - MIN_PIECE_X);
+							continue;
+						}
+
+						while (shift < positions.shiftCount && positions.shifts[shift].to != rotatedX - MIN_PIECE_X)
+						{
+							shift++;
+						}
+
+						if (shift == positions.shiftCount)
+						{
+							positions.shifts[positions.shiftCount++].to = rotatedX - MIN_PIECE_X;
+						}
+
+						positions.shifts[shift].from |= 1 << (x - MIN_PIECE_X);
+					}
+				}
+			}
+
+			return table;
+		}
+
+		// Indexed by the piece and the rotation it turns to.
+		const RotatedPositionTable ROTATED_POSITIONS{ BuildRotatedPositions() };
+
+		typedef std::array<unsigned, BOARD_HEIGHT_IN_BLOCKS + BOARD_PADDING_ROWS> PositionBoard;
+
+		// The board shifted so that bit x - MIN_PIECE_X of a row is column x.
+		// Column -1 and the columns past the right wall count as solid.
+		// Returns the number of empty rows at the top.
+		int FillPositionBoard(const Bitboard& board, PositionBoard& positionBoard)
+		{
+			int emptyRows{ -1 };
+
+			for (int i{}; i < (int)positionBoard.size(); i++)
+			{
+				positionBoard[i] = (unsigned)(board.GetRow(i) << -MIN_PIECE_X) | 1u | OUTSIDE_BOARD_MASK;
+
+				if (emptyRows < 0 && board.GetRow(i) != WALLS_ROW_MASK)
+				{
+					emptyRows = i;
+				}
+			}
+
+			return emptyRows;
+		}
+
+		// Positions at row y where the piece does not collide.
+		PositionRow GetFreePositions(const PositionBoard& positionBoard, const PieceLayout& layout, int y)
+		{
+			unsigned blocked{};
+
+			for (const CellOffset& cell : layout.cells)
+			{
+				blocked |= positionBoard[y + cell.y] >> cell.x;
+			}
+
+			return (PositionRow)(~blocked & ALL_POSITIONS_MASK);
+		}
+
+		// Spreads the reached positions left and right through free ones.
+		PositionRow FillRow(PositionRow reached, PositionRow free)
+		{
+			unsigned left{ reached }, right{ reached }, leftFree{ free }, rightFree{ free };
+
+			for (int shift{ 1 }; shift < PIECE_X_POSITIONS; shift *= 2)
+			{
+				left |= leftFree & (left << shift);
+				leftFree &= leftFree << shift;
+				right |= rightFree & (right >> shift);
+				rightFree &= rightFree >> shift;
+			}
+
+			return (PositionRow)(left | right);
+		}
+
+		PositionRow RotatePositions(const RotatedPositions& positions, PositionRow reached)
+		{
+			unsigned rotated{ (unsigned)(reached & positions.unshifted) };
+
+			for (int i{}; i < positions.shiftCount; i++)
+			{
+				rotated |= (unsigned)((reached & positions.shifts[i].from) != 0) << positions.shifts[i].to;
+			}
+
+			return (PositionRow)rotated;
+		}
+
+		int GetStateIndex(int rotation, int x, int y)
+		{
+			return (rotation * PIECE_X_POSITIONS + x - MIN_PIECE_X) * BOARD_HEIGHT_IN_BLOCKS + y;
+		}
+	}
+
+	int PlacementGenerator::Generate(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position)
+	{
+		const int kind{ static_cast<int>(figure) };
+		std::array<PositionRow, PIECE_ROTATIONS> reached{}, free{}, freeBelow{}, locked{};
+		PositionRow anyReached{};
+		int changed{ 1 << rotation };
+		PositionBoard positionBoard;
+
+		int emptyRows{ FillPositionBoard(board, positionBoard) };
+
+		count = 0;
+
+		for (int i{}; i < PIECE_ROTATIONS; i++)
+		{
+			free[i] = GetFreePositions(positionBoard, PIECE_LAYOUTS[kind][i], position.y);
+		}
+
+		reached[rotation] = free[rotation] & (1 << (position.x - MIN_PIECE_X));
+		anyReached = reached[rotation];
+
+		for (int y{ position.y }; y < BOARD_HEIGHT_IN_BLOCKS && anyReached != 0; y++)
+		{
+			// changed holds the rotations whose moves have to be tried again.
+			// Moving down onto a row the piece fits in the same way keeps the
+			// reached positions closed under the sideways moves and rotation.
+			for (int i{}; changed != 0; i = (i + 1) % PIECE_ROTATIONS)
+			{
+				if ((changed & 1 << i) == 0)
+				{
+					continue;
+				}
+
+				int next{ (i + 1) % PIECE_ROTATIONS };
+
+				changed &= ~(1 << i);
+				reached[i] = FillRow(reached[i], free[i]);
+
+				PositionRow rotated{ (PositionRow)(RotatePositions(ROTATED_POSITIONS[kind][next], reached[i]) & free[next]) };
+
+				if ((rotated & ~reached[next]) != 0)
+				{
+					reached[next] |= rotated;
+					changed |= 1 << next;
+				}
+			}
+
+			// Rows above the stack all look the same to the piece, so it can
+			// drop straight to where the stack comes into reach.
+			if (y + 1 + MAX_PIECE_SIZE <= emptyRows)
+			{
+				y = emptyRows - MAX_PIECE_SIZE - 1;
+			}
+
+			locked.fill(0);
+			anyReached = 0;
+
+			for (int i{}; i < PIECE_ROTATIONS; i++)
+			{
+				freeBelow[i] = CANONICAL_ROTATIONS[kind][i] == i
+					? GetFreePositions(positionBoard, PIECE_LAYOUTS[kind][i], y + 1)
+					: freeBelow[CANONICAL_ROTATIONS[kind][i]];
+				locked[CANONICAL_ROTATIONS[kind][i]] |= reached[i] & ~freeBelow[i];
+				reached[i] &= freeBelow[i];
+				anyReached |= reached[i];
+			}
+
+			for (int i{}; i < PIECE_ROTATIONS; i++)
+			{
+				int next{ (i + 1) % PIECE_ROTATIONS };
+
+				if (reached[i] != 0 && (freeBelow[i] != free[i] || freeBelow[next] != free[next]))
+				{
+					changed |= 1 << i;
+				}
+			}
+
+			for (int i{}; i < PIECE_ROTATIONS; i++)
+			{
+				for (int x{ MIN_PIECE_X }; locked[i] != 0; x++, locked[i] >>= 1)
+				{
+					if ((locked[i] & 1) != 0)
+					{
+						placements[count++] = { x, y, i };
+					}
+				}
+			}
+
+			free = freeBelow;
+		}
+
+		return count;
+	}
+
+	int PlacementGenerator::GetCount() const
+	{
+		return count;
+	}
+
+	const Placement& PlacementGenerator::GetPlacement(int index) const
+	{
+		return placements[index];
+	}
+
+	int PlacementGenerator::GenerateBySearch(const Bitboard& board, FigureKind figure, size_t rotation,
+		PiecePosition position)
+	{
+		count = 0;
+		Search(board, figure, rotation, position, nullptr);
+
+		return count;
+	}
+
+	int PlacementGenerator::FindPath(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position,
+		const Placement& placement, PieceMovement* path, int capacity)
+	{
+		int start{ GetStateIndex((int)rotation, position.x, position.y) };
+		int state{ Search(board, figure, rotation, position, &placement) };
+
+		if (state < 0)
+		{
+			return -1;
+		}
+
+		int length{ 1 };
+
+		for (int i{ state }; i != start; i = parents[i])
+		{
+			length++;
+		}
+
+		if (length > capacity)
+		{
+			return -1;
+		}
+
+		path[length - 1] = PieceMovement::SpeedUp;
+
+		for (int i{ state }, j{ length - 2 }; i != start; i = parents[i], j--)
+		{
+			path[j] = parentMovements[i];
+		}
+
+		return length;
+	}
+
+	int PlacementGenerator::Search(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position,
+		const Placement* target)
+	{
+		const int kind{ static_cast<int>(figure) };
+
+		if (board.IsCollision(figure, rotation, position.x, position.y))
+		{
+			return -1;
+		}
+
+		if (++search == 0)
+		{
+			visitedSearch.fill(0);
+			placedSearch.fill(0);
+			search = 1;
+		}
+
+		int head{}, tail{};
+		int start{ GetStateIndex((int)rotation, position.x, position.y) };
+
+		visitedSearch[start] = search;
+		queue[tail++] = (uint16_t)start;
+
+		while (head < tail)
+		{
+			int state{ queue[head++] };
+			int y{ state % BOARD_HEIGHT_IN_BLOCKS };
+			int x{ state / BOARD_HEIGHT_IN_BLOCKS % PIECE_X_POSITIONS + MIN_PIECE_X };
+			int stateRotation{ state / BOARD_HEIGHT_IN_BLOCKS / PIECE_X_POSITIONS };
+			int canonicalRotation{ CANONICAL_ROTATIONS[kind][stateRotation] };
+			bool isLanded{ board.IsCollision(figure, stateRotation, x, y + 1) };
+
+			if (isLanded && target == nullptr)
+			{
+				int placed{ GetStateIndex(canonicalRotation, x, y) };
+
+				if (placedSearch[placed] != search)
+				{
+					placedSearch[placed] = search;
+					placements[count++] = { x, y, canonicalRotation };
+				}
+			}
+			else if (isLanded
+				&& x == target->x && y == target->y
+				&& canonicalRotation == CANONICAL_ROTATIONS[kind][target->rotation])
+			{
+				return state;
+			}
+
+			int nextRotation{ (stateRotation + 1) % PIECE_ROTATIONS };
+			int rotatedX{ Engine::CalculateRotatedX(figure, nextRotation, x) };
+
+			struct Move
+			{
+				PieceMovement movement;
+				int rotation;
+				int x;
+				int y;
+			};
+
+			const Move moves[]
+			{
+				{ PieceMovement::Left, stateRotation, x - 1, y },
+				{ PieceMovement::Right, stateRotation, x + 1, y },
+				{ PieceMovement::Rotation, nextRotation, rotatedX, y },
+				{ PieceMovement::SpeedUp, stateRotation, x, y + 1 }
+			};
+
+			for (const Move& move : moves)
+			{
+				if (move.x < MIN_PIECE_X || move.x >= BOARD_WIDTH_IN_BLOCKS
+					|| (move.movement == PieceMovement::SpeedUp && isLanded)
+					|| board.IsCollision(figure, move.rotation, move.x, move.y))
+				{
+					continue;
+				}
+
+				int next{ GetStateIndex(move.rotation, move.x, move.y) };
+
+				if (visitedSearch[next] == search)
+				{
+					continue;
+				}
+
+				visitedSearch[next] = search;
+				parents[next] = (uint16_t)state;
+				parentMovements[next] = move.movement;
+				queue[tail++] = (uint16_t)next;
+			}
+		}
+
+		return -1;
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "Engine.h"
+#include <array>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	const int
+		MAX_PLACEMENTS{ PIECE_ROTATIONS * PIECE_X_POSITIONS * BOARD_HEIGHT_IN_BLOCKS },
+		MAX_PLACEMENT_PATH{ MAX_PLACEMENTS };
+
+	// Where a piece comes to rest: it can no longer move down, so it locks on
+	// the next gravity tick that is not spent on a sideways move or rotation.
+	struct Placement
+	{
+		int x{};
+		int y{};
+		int rotation{};
+	};
+
+	// For every piece and rotation, the lowest rotation whose shape is exactly
+	// the same. Turning the O piece, or the I, N and N_mirrored pieces twice,
+	// gives back the same cells, so those placements are reported only once.
+	constexpr std::array<std::array<int, PIECE_ROTATIONS>, PIECE_KINDS> BuildCanonicalRotations()
+	{
+		std::array<std::array<int, PIECE_ROTATIONS>, PIECE_KINDS> table{};
+
+		for (int kind{}; kind < PIECE_KINDS; kind++)
+		{
+			for (int rotation{}; rotation < PIECE_ROTATIONS; rotation++)
+			{
+				table[kind][rotation] = rotation;
+
+				for (int other{}; other < rotation; other++)
+				{
+					const PieceLayout& layout{ PIECE_LAYOUTS[kind][rotation] };
+					const PieceLayout& otherLayout{ PIECE_LAYOUTS[kind][other] };
+					bool isSame{ layout.width == otherLayout.width };
+
+					for (int i{}; i < MAX_PIECE_SIZE; i++)
+					{
+						isSame = isSame && layout.rowMasks[i] == otherLayout.rowMasks[i];
+					}
+
+					if (isSame)
+					{
+						table[kind][rotation] = other;
+						break;
+					}
+				}
+			}
+		}
+
+		return table;
+	}
+
+	constexpr std::array<std::array<int, PIECE_ROTATIONS>, PIECE_KINDS> CANONICAL_ROTATIONS
+	{
+		BuildCanonicalRotations()
+	};
+
+	static_assert(CANONICAL_ROTATIONS[static_cast<int>(FigureKind::Square)][3] == 0, "O piece has one shape");
+	static_assert(CANONICAL_ROTATIONS[static_cast<int>(FigureKind::I)][3] == 1, "I piece has two shapes");
+	static_assert(CANONICAL_ROTATIONS[static_cast<int>(FigureKind::T)][3] == 3, "T piece has four shapes");
+
+	// Finds every placement a piece can reach from where it is with the moves
+	// Engine allows: left, right, rotation (with its wall shift) and down. A
+	// piece keeps sliding as long as a move is made every tick, so moves along
+	// the stack and tucks under overhangs are found too.
+	//
+	// Generate works on whole rows at once: bit x + 1 of a row mask stands for
+	// the piece at column x, so every column of a row is tested, filled and
+	// moved down with a few bit operations. FindPath is a plain breadth-first
+	// search that is only run for the placement actually chosen. None of them
+	// allocates; all storage lives in the generator.
+	class PlacementGenerator
+	{
+	public:
+		int Generate(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position);
+		int GetCount() const;
+		const Placement& GetPlacement(int index) const;
+
+		// Finds the same placements as Generate, in another order, by trying
+		// one move at a time with Bitboard::IsCollision the way Engine does.
+		// Much slower; it is kept to check Generate against.
+		int GenerateBySearch(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position);
+
+		// Fills path with the shortest input sequence, one movement per tick,
+		// that takes the piece to placement. It ends with a SpeedUp against
+		// the stack; holding SpeedUp from there locks the piece. Returns the
+		// number of movements, or -1 if the placement cannot be reached or
+		// the path does not fit in capacity.
+		int FindPath(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position,
+			const Placement& placement, PieceMovement* path, int capacity);
+
+	private:
+		std::array<Placement, MAX_PLACEMENTS> placements{};
+		int count{};
+
+		std::array<uint32_t, MAX_PLACEMENTS> visitedSearch{};
+		std::array<uint32_t, MAX_PLACEMENTS> placedSearch{};
+		std::array<uint16_t, MAX_PLACEMENTS> parents{};
+		std::array<PieceMovement, MAX_PLACEMENTS> parentMovements{};
+		std::array<uint16_t, MAX_PLACEMENTS> queue{};
+		uint32_t search{};
+
+		// Breadth-first search from position. Collects every placement when
+		// target is null; otherwise stops at target and returns its state.
+		int Search(const Bitboard& board, FigureKind figure, size_t rotation, PiecePosition position,
+			const Placement* target);
+	};
+}
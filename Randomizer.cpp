@@ -0,0 +1,174 @@
+#include "Randomizer.h"
+
+namespace GameNamespace
+{
+	namespace
+	{
+		uint64_t RotateLeft(uint64_t value, int shift)
+		{
+			return (value << shift) | (value >> (64 - shift));
+		}
+	}
+
+	Xoshiro256::Xoshiro256(uint64_t seed)
+	{
+		Seed(seed);
+	}
+
+	void Xoshiro256::Seed(uint64_t seed)
+	{
+		for (uint64_t& word : state)
+		{
+			word = SplitMix64(seed);
+		}
+	}
+
+	uint64_t Xoshiro256::Next()
+	{
+		uint64_t result{ RotateLeft(state[1] * 5, 7) * 9 };
+		uint64_t shifted{ state[1] << 17 };
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= shifted;
+		state[3] = RotateLeft(state[3], 45);
+
+		return result;
+	}
+
+	uint32_t Xoshiro256::NextBelow(uint32_t bound)
+	{
+		// Lemire's multiply and shift with rejection of the biased low range.
+		uint64_t product{ (Next() >> 32) * bound };
+		uint32_t low{ (uint32_t)product };
+
+		if (low < bound)
+		{
+			uint32_t threshold{ (0u - bound) % bound };
+
+			while (low < threshold)
+			{
+				product = (Next() >> 32) * bound;
+				low = (uint32_t)product;
+			}
+		}
+
+		return (uint32_t)(product >> 32);
+	}
+
+	PieceRandomizer::PieceRandomizer(uint64_t seed, RandomizerKind kind)
+	{
+		Reset(seed, kind);
+	}
+
+	void PieceRandomizer::Reset(uint64_t seed, RandomizerKind kind)
+	{
+		this->kind = kind;
+
+		generator.Seed(seed);
+		batchPosition = PIECE_BATCH_SIZE;
+		bagPosition = PIECE_KINDS;
+
+		// The usual history randomizer start: as if S and Z had just been
+		// dealt twice, so the first piece is never one of them.
+		history = { FigureKind::N, FigureKind::N_mirrored, FigureKind::N, FigureKind::N_mirrored };
+	}
+
+	SpawnedPiece PieceRandomizer::Next()
+	{
+		if (batchPosition == PIECE_BATCH_SIZE)
+		{
+			Generate(batch.data(), PIECE_BATCH_SIZE);
+			batchPosition = 0;
+		}
+
+		return batch[batchPosition++];
+	}
+
+	void PieceRandomizer::Generate(SpawnedPiece* pieces, int count)
+	{
+		for (int i{}; i < count; i++)
+		{
+			pieces[i].figure = NextFigure();
+			pieces[i].rotation = (int)generator.NextBelow(PIECE_ROTATIONS);
+		}
+	}
+
+	RandomizerKind PieceRandomizer::GetKind() const
+	{
+		return kind;
+	}
+
+	FigureKind PieceRandomizer::NextFigure()
+	{
+		switch (kind)
+		{
+		case RandomizerKind::SevenBag:
+			return NextBagFigure();
+
+		case RandomizerKind::History:
+			return NextHistoryFigure();
+
+		case RandomizerKind::Uniform:
+		default:
+			return (FigureKind)generator.NextBelow(PIECE_KINDS);
+		}
+	}
+
+	FigureKind PieceRandomizer::NextBagFigure()
+	{
+		if (bagPosition == PIECE_KINDS)
+		{
+			for (int i{}; i < PIECE_KINDS; i++)
+			{
+				bag[i] = (FigureKind)i;
+			}
+
+			for (int i{ PIECE_KINDS - 1 }; i > 0; i--)
+			{
+				int j{ (int)generator.NextBelow(i + 1) };
+				FigureKind swapped{ bag[i] };
+
+				bag[i] = bag[j];
+				bag[j] = swapped;
+			}
+
+			bagPosition = 0;
+		}
+
+		return bag[bagPosition++];
+	}
+
+	FigureKind PieceRandomizer::NextHistoryFigure()
+	{
+		FigureKind figure{};
+
+		for (int roll{}; roll < RANDOMIZER_HISTORY_ROLLS; roll++)
+		{
+			figure = (FigureKind)generator.NextBelow(PIECE_KINDS);
+
+			bool isRecent{};
+
+			for (FigureKind recent : history)
+			{
+				isRecent = isRecent || recent == figure;
+			}
+
+			if (!isRecent)
+			{
+				break;
+			}
+		}
+
+		for (int i{ RANDOMIZER_HISTORY_SIZE - 1 }; i > 0; i--)
+		{
+			history[i] = history[i - 1];
+		}
+
+		history[0] = figure;
+
+		return figure;
+	}
+}
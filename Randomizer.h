@@ -0,0 +1,80 @@
+#pragma once
+#include "Pieces.h"
+#include <array>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	const int
+		PIECE_BATCH_SIZE{ 64 },
+		RANDOMIZER_HISTORY_SIZE{ 4 },
+		RANDOMIZER_HISTORY_ROLLS{ 4 };
+
+	enum class RandomizerKind
+	{
+		Uniform,
+		SevenBag,
+		History
+	};
+
+	struct SpawnedPiece
+	{
+		FigureKind figure{};
+		int rotation{};
+	};
+
+	// Advances state and returns the next splitmix64 output. Seeds
+	// Xoshiro256 and fills the Zobrist keys.
+	constexpr uint64_t SplitMix64(uint64_t& state)
+	{
+		uint64_t value{ state += 0x9E3779B97F4A7C15ull };
+
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+		return value ^ (value >> 31);
+	}
+
+	// xoshiro256** seeded through SplitMix64. Small, fast and fully
+	// determined by its seed, so every game can own one.
+	class Xoshiro256
+	{
+	public:
+		Xoshiro256(uint64_t seed = 0);
+
+		void Seed(uint64_t seed);
+		uint64_t Next();
+		uint32_t NextBelow(uint32_t bound);
+
+	private:
+		std::array<uint64_t, 4> state{};
+	};
+
+	// Chooses the pieces of one game. Uniform draws every piece independently,
+	// SevenBag deals shuffled bags of all seven pieces and History rerolls a
+	// piece that is among the last few dealt. Pieces are generated ahead in
+	// batches; Generate fills any number of them at once.
+	class PieceRandomizer
+	{
+	public:
+		PieceRandomizer(uint64_t seed = 0, RandomizerKind kind = RandomizerKind::Uniform);
+
+		void Reset(uint64_t seed, RandomizerKind kind);
+		SpawnedPiece Next();
+		void Generate(SpawnedPiece* pieces, int count);
+		RandomizerKind GetKind() const;
+
+	private:
+		Xoshiro256 generator{};
+		RandomizerKind kind{};
+		std::array<SpawnedPiece, PIECE_BATCH_SIZE> batch{};
+		int batchPosition{};
+		std::array<FigureKind, PIECE_KINDS> bag{};
+		int bagPosition{};
+		std::array<FigureKind, RANDOMIZER_HISTORY_SIZE> history{};
+
+		FigureKind NextFigure();
+		FigureKind NextBagFigure();
+		FigureKind NextHistoryFigure();
+	};
+}
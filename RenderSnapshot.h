@@ -0,0 +1,29 @@
+#pragma once
+#include <SDL.h>
+#include "Constants.h"
+#include "Engine.h"
+
+namespace GameNamespace
+{
+	// Everything a frame draws, copied out of the game after the
+	// logic ticks of a frame. interpolation is how far the game was towards
+	// the next tick when the snapshot was published at publishedAt, in
+	// performance counter units.
+	struct RenderSnapshot
+	{
+		GameState gameState{ GameState::MenuMode };
+		Bitboard board{};
+		long long boardVersion{ -1 };
+		FigureKind figure{};
+		size_t rotation{};
+		FigureKind nextFigure{};
+		size_t nextRotation{};
+		PiecePosition position{};
+		PiecePosition previousPosition{};
+		bool isNewPiece{};
+		int ghostRow{};
+		int score{};
+		double interpolation{};
+		Uint64 publishedAt{};
+	};
+}
@@ -0,0 +1,237 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const char REPLAY_TAG[]{ 'T', 'R', 'P', 'L' };
+		const int MOVEMENT_BITS{ 3 };
+
+		void WriteVarint(std::vector<uint8_t>& data, uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				data.push_back((uint8_t)(value | 0x80));
+				value >>= 7;
+			}
+
+			data.push_back((uint8_t)value);
+		}
+
+		bool ReadVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value)
+		{
+			value = 0;
+
+			for (int shift{}; shift < 64 && data != end; shift += 7)
+			{
+				uint8_t byte{ *data++ };
+
+				value |= (uint64_t)(byte & 0x7F) << shift;
+
+				if ((byte & 0x80) == 0)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	void ReplayRecorder::Begin(uint64_t seed, RandomizerKind randomizerKind)
+	{
+		data.assign(std::begin(REPLAY_TAG), std::end(REPLAY_TAG));
+		data.push_back(REPLAY_VERSION);
+		data.push_back((uint8_t)randomizerKind);
+		WriteVarint(data, seed);
+
+		tick = 0;
+		lastInputTick = 0;
+		isRecording = true;
+	}
+
+	void ReplayRecorder::Record(PieceMovement movement)
+	{
+		if (!isRecording || movement == PieceMovement::None)
+		{
+			return;
+		}
+
+		WriteVarint(data, (uint64_t)(tick - lastInputTick) << MOVEMENT_BITS | (uint64_t)movement);
+		lastInputTick = tick;
+	}
+
+	void ReplayRecorder::EndTick()
+	{
+		tick++;
+	}
+
+	void ReplayRecorder::Finish(int score, long long lockedPieces)
+	{
+		if (!isRecording)
+		{
+			return;
+		}
+
+		WriteVarint(data, 0);
+		WriteVarint(data, (uint64_t)tick);
+		WriteVarint(data, (uint64_t)score);
+		WriteVarint(data, (uint64_t)lockedPieces);
+
+		isRecording = false;
+	}
+
+	bool ReplayRecorder::Save(const char* path) const
+	{
+		std::ofstream file{ path, std::ios::binary };
+
+		file.write((const char*)data.data(), data.size());
+
+		return (bool)file;
+	}
+
+	bool ReplayRecorder::IsRecording() const
+	{
+		return isRecording;
+	}
+
+	const std::vector<uint8_t>& ReplayRecorder::GetData() const
+	{
+		return data;
+	}
+
+	bool ReplayPlayer::Load(const char* path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+
+		if (!file)
+		{
+			return false;
+		}
+
+		std::vector<uint8_t> data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+		return Load(data.data(), data.size());
+	}
+
+	bool ReplayPlayer::Load(const uint8_t* data, size_t size)
+	{
+		const uint8_t* end{ data + size };
+		uint64_t value{};
+
+		inputs.clear();
+		Rewind();
+
+		if (size < sizeof(REPLAY_TAG) + 2
+			|| !std::equal(std::begin(REPLAY_TAG), std::end(REPLAY_TAG), data)
+			|| data[sizeof(REPLAY_TAG)] != REPLAY_VERSION
+			|| data[sizeof(REPLAY_TAG) + 1] > (uint8_t)RandomizerKind::History)
+		{
+			return false;
+		}
+
+		randomizerKind = (RandomizerKind)data[sizeof(REPLAY_TAG) + 1];
+		data += sizeof(REPLAY_TAG) + 2;
+
+		if (!ReadVarint(data, end, seed))
+		{
+			return false;
+		}
+
+		long long tick{};
+		int tickInputs{};
+
+		while (ReadVarint(data, end, value) && value != 0)
+		{
+			uint64_t movement{ value & ((1 << MOVEMENT_BITS) - 1) };
+
+			if (movement == 0 || movement > (uint64_t)PieceMovement::HardDrop)
+			{
+				return false;
+			}
+
+			tickInputs = (value >> MOVEMENT_BITS) == 0 ? tickInputs + 1 : 1;
+
+			// No tick can apply more actions than the input queue holds.
+			if (tickInputs > INPUT_QUEUE_CAPACITY)
+			{
+				return false;
+			}
+
+			tick += (long long)(value >> MOVEMENT_BITS);
+			inputs.push_back({ tick, (PieceMovement)movement });
+		}
+
+		uint64_t ticks{}, score{}, lockedPieces{};
+
+		if (value != 0
+			|| !ReadVarint(data, end, ticks)
+			|| !ReadVarint(data, end, score)
+			|| !ReadVarint(data, end, lockedPieces))
+		{
+			return false;
+		}
+
+		summary = { (long long)ticks, (int)score, (long long)lockedPieces };
+
+		return true;
+	}
+
+	void ReplayPlayer::Rewind()
+	{
+		nextInput = 0;
+		tick = 0;
+	}
+
+	int ReplayPlayer::ReadTick(PieceMovement* movements, int capacity)
+	{
+		int count{};
+
+		while (nextInput < inputs.size() && inputs[nextInput].tick == tick && count < capacity)
+		{
+			movements[count++] = inputs[nextInput++].movement;
+		}
+
+		tick++;
+
+		return count;
+	}
+
+	bool ReplayPlayer::IsFinished() const
+	{
+		return tick >= summary.ticks;
+	}
+
+	ReplaySummary ReplayPlayer::Simulate(Engine& engine)
+	{
+		std::array<PieceMovement, INPUT_QUEUE_CAPACITY> movements{};
+
+		engine.Reset(seed, randomizerKind);
+		Rewind();
+
+		while (!IsFinished())
+		{
+			engine.Tick(movements.data(), ReadTick(movements.data(), INPUT_QUEUE_CAPACITY));
+		}
+
+		return { tick, engine.GetScore(), engine.GetLockedPieces() };
+	}
+
+	uint64_t ReplayPlayer::GetSeed() const
+	{
+		return seed;
+	}
+
+	RandomizerKind ReplayPlayer::GetRandomizerKind() const
+	{
+		return randomizerKind;
+	}
+
+	const ReplaySummary& ReplayPlayer::GetSummary() const
+	{
+		return summary;
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Engine.h"
+#include "InputQueue.h"
+#include <cstdint>
+#include <vector>
+
+namespace GameNamespace
+{
+	const uint8_t REPLAY_VERSION{ 1 };
+
+	struct ReplayInput
+	{
+		long long tick{};
+		PieceMovement movement{};
+	};
+
+	struct ReplaySummary
+	{
+		long long ticks{};
+		int score{};
+		long long lockedPieces{};
+	};
+
+	// Writes a game as its seed followed by every applied action, stamped with
+	// the logic tick it was applied in. The file is a "TRPL" tag, the format
+	// version, the randomizer kind and the seed, then one varint per action
+	// holding (ticks since the previous action << 3 | movement), a zero, and
+	// the final tick count, score and locked pieces as varints.
+	class ReplayRecorder
+	{
+	public:
+		void Begin(uint64_t seed, RandomizerKind randomizerKind);
+		void Record(PieceMovement movement);
+		void EndTick();
+		void Finish(int score, long long lockedPieces);
+		bool Save(const char* path) const;
+		bool IsRecording() const;
+		const std::vector<uint8_t>& GetData() const;
+
+	private:
+		std::vector<uint8_t> data{};
+		long long tick{};
+		long long lastInputTick{};
+		bool isRecording{};
+	};
+
+	// Reads a replay back and hands out the actions tick by tick, either to a
+	// live Game or to Simulate, which replays it on an Engine at full speed.
+	class ReplayPlayer
+	{
+	public:
+		bool Load(const char* path);
+		bool Load(const uint8_t* data, size_t size);
+		void Rewind();
+		int ReadTick(PieceMovement* movements, int capacity);
+		bool IsFinished() const;
+		ReplaySummary Simulate(Engine& engine);
+
+		uint64_t GetSeed() const;
+		RandomizerKind GetRandomizerKind() const;
+		const ReplaySummary& GetSummary() const;
+
+	private:
+		std::vector<ReplayInput> inputs{};
+		uint64_t seed{};
+		RandomizerKind randomizerKind{};
+		ReplaySummary summary{};
+		size_t nextInput{};
+		long long tick{};
+	};
+}
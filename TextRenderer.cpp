@@ -0,0 +1,228 @@
+#include "TextRenderer.h"
+#include "GameExceptions.h"
+
+namespace GameNamespace
+{
+	GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, OpenGLRenderer* openGL, TTF_Font* font)
+	{
+		this->font = font;
+		this->openGL = openGL;
+
+		const SDL_Color white{ 255, 255, 255, 255 };
+		std::array<SDL_Surface*, GLYPH_COUNT> surfaces{};
+		int x{}, y{}, rowHeight{};
+
+		for (int i{}; i < GLYPH_COUNT; i++)
+		{
+			char text[]{ (char)(FIRST_GLYPH + i), '\0' };
+
+			surfaces[i] = TTF_RenderText_Solid(font, text, white);
+
+			if (surfaces[i] == NULL)
+			{
+				throw SurfaceNullReference();
+			}
+
+			if (x + surfaces[i]->w > GLYPH_ATLAS_WIDTH)
+			{
+				x = 0;
+				y += rowHeight;
+				rowHeight = 0;
+			}
+
+			glyphs[i] = { x, y, surfaces[i]->w, surfaces[i]->h };
+			x += surfaces[i]->w;
+			rowHeight = surfaces[i]->h > rowHeight ? surfaces[i]->h : rowHeight;
+			height = surfaces[i]->h > height ? surfaces[i]->h : height;
+		}
+
+		SDL_Surface* atlas{
+			SDL_CreateRGBSurfaceWithFormat(0, GLYPH_ATLAS_WIDTH, y + rowHeight, 32, SDL_PIXELFORMAT_RGBA32)
+		};
+
+		if (atlas == NULL)
+		{
+			throw SurfaceNullReference();
+		}
+
+		for (int i{}; i < GLYPH_COUNT; i++)
+		{
+			SDL_BlitSurface(surfaces[i], NULL, atlas, &glyphs[i]);
+			SDL_FreeSurface(surfaces[i]);
+		}
+
+		if (openGL != nullptr)
+		{
+			openGLTexture = openGL->AddTexture(atlas);
+			SDL_FreeSurface(atlas);
+			return;
+		}
+
+		texture = SDL_CreateTextureFromSurface(renderer, atlas);
+		SDL_FreeSurface(atlas);
+
+		if (texture == NULL)
+		{
+			throw TextureNullReference();
+		}
+
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	}
+
+	GlyphAtlas::~GlyphAtlas()
+	{
+		SDL_DestroyTexture(texture);
+	}
+
+	TTF_Font* GlyphAtlas::GetFont() const
+	{
+		return font;
+	}
+
+	int GlyphAtlas::MeasureText(const char* text) const
+	{
+		int width{};
+
+		for (; *text != '\0'; text++)
+		{
+			if (*text >= FIRST_GLYPH && *text <= LAST_GLYPH)
+			{
+				width += glyphs[*text - FIRST_GLYPH].w;
+			}
+		}
+
+		return width;
+	}
+
+	void GlyphAtlas::DrawText(SDL_Renderer* renderer, const char* text, SDL_Color color, const SDL_Rect& rectangle)
+	{
+		int width{ MeasureText(text) };
+
+		if (width == 0)
+		{
+			return;
+		}
+
+		if (openGL == nullptr)
+		{
+			SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+		}
+
+		int x{};
+
+		for (; *text != '\0'; text++)
+		{
+			if (*text < FIRST_GLYPH || *text > LAST_GLYPH)
+			{
+				continue;
+			}
+
+			const SDL_Rect& glyph{ glyphs[*text - FIRST_GLYPH] };
+			int left{ rectangle.x + x * rectangle.w / width };
+
+			x += glyph.w;
+
+			SDL_Rect target
+			{
+				left,
+				rectangle.y,
+				rectangle.x + x * rectangle.w / width - left,
+				glyph.h * rectangle.h / height
+			};
+
+			if (openGL != nullptr)
+			{
+				openGL->Draw(openGLTexture, &glyph, &target, { color.r, color.g, color.b, SDL_ALPHA_OPAQUE });
+			}
+			else
+			{
+				SDL_RenderCopy(renderer, texture, &glyph, &target);
+			}
+		}
+	}
+
+	TextRenderer::TextRenderer(SDL_Renderer* renderer, OpenGLRenderer* openGL)
+	{
+		this->renderer = renderer;
+		this->openGL = openGL;
+	}
+
+	TextRenderer::~TextRenderer()
+	{
+		for (SDL_Texture* text : staticTexts)
+		{
+			SDL_DestroyTexture(text);
+		}
+	}
+
+	void TextRenderer::LoadFont(TTF_Font* font)
+	{
+		GetAtlas(font);
+	}
+
+	size_t TextRenderer::AddStaticText(TTF_Font* font, const char* text, SDL_Color color)
+	{
+		SDL_Surface* surface{
+			TTF_RenderText_Solid(font, text, color)
+		};
+
+		if (surface == NULL)
+		{
+			throw SurfaceNullReference();
+		}
+
+		if (openGL != nullptr)
+		{
+			openGLStaticTexts.push_back(openGL->AddTexture(surface));
+			SDL_FreeSurface(surface);
+
+			return openGLStaticTexts.size() - 1;
+		}
+
+		SDL_Texture* message{
+			SDL_CreateTextureFromSurface(renderer, surface)
+		};
+
+		SDL_FreeSurface(surface);
+
+		if (message == NULL)
+		{
+			throw MessageNullReference();
+		}
+
+		staticTexts.push_back(message);
+
+		return staticTexts.size() - 1;
+	}
+
+	void TextRenderer::DrawStaticText(size_t text, const SDL_Rect& rectangle)
+	{
+		if (openGL != nullptr)
+		{
+			openGL->Draw(openGLStaticTexts[text], NULL, &rectangle, { 255, 255, 255, SDL_ALPHA_OPAQUE });
+			return;
+		}
+
+		SDL_RenderCopy(renderer, staticTexts[text], NULL, &rectangle);
+	}
+
+	void TextRenderer::DrawText(TTF_Font* font, const char* text, SDL_Color color, const SDL_Rect& rectangle)
+	{
+		GetAtlas(font).DrawText(renderer, text, color, rectangle);
+	}
+
+	GlyphAtlas& TextRenderer::GetAtlas(TTF_Font* font)
+	{
+		for (const std::unique_ptr<GlyphAtlas>& atlas : atlases)
+		{
+			if (atlas->GetFont() == font)
+			{
+				return *atlas;
+			}
+		}
+
+		atlases.push_back(std::make_unique<GlyphAtlas>(renderer, openGL, font));
+
+		return *atlases.back();
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "OpenGLRenderer.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace GameNamespace
+{
+	const int
+		FIRST_GLYPH{ 32 },
+		LAST_GLYPH{ 126 },
+		GLYPH_COUNT{ LAST_GLYPH - FIRST_GLYPH + 1 },
+		GLYPH_ATLAS_WIDTH{ 1024 };
+
+	// Every printable ASCII glyph of one font, rendered once into a single
+	// texture. Drawing text copies glyph rectangles out of it, so it costs no
+	// surface or texture work after construction. With an OpenGL renderer the
+	// texture is one of its own and renderer is unused.
+	class GlyphAtlas
+	{
+	public:
+		GlyphAtlas(SDL_Renderer* renderer, OpenGLRenderer* openGL, TTF_Font* font);
+		~GlyphAtlas();
+
+		GlyphAtlas(const GlyphAtlas&) = delete;
+		GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+		TTF_Font* GetFont() const;
+		int MeasureText(const char* text) const;
+		void DrawText(SDL_Renderer* renderer, const char* text, SDL_Color color, const SDL_Rect& rectangle);
+
+	private:
+		TTF_Font* font{};
+		OpenGLRenderer* openGL{};
+		SDL_Texture* texture{};
+		size_t openGLTexture{};
+		std::array<SDL_Rect, GLYPH_COUNT> glyphs{};
+		int height{};
+	};
+
+	// Text drawing for the game: dynamic text through one glyph atlas per font
+	// and fixed strings rendered once into their own textures. Both are
+	// stretched to fill the rectangle they are drawn into.
+	class TextRenderer
+	{
+	public:
+		TextRenderer(SDL_Renderer* renderer, OpenGLRenderer* openGL = nullptr);
+		~TextRenderer();
+
+		TextRenderer(const TextRenderer&) = delete;
+		TextRenderer& operator=(const TextRenderer&) = delete;
+
+		void LoadFont(TTF_Font* font);
+		size_t AddStaticText(TTF_Font* font, const char* text, SDL_Color color);
+		void DrawStaticText(size_t text, const SDL_Rect& rectangle);
+		void DrawText(TTF_Font* font, const char* text, SDL_Color color, const SDL_Rect& rectangle);
+
+	private:
+		SDL_Renderer* renderer{};
+		OpenGLRenderer* openGL{};
+		std::vector<std::unique_ptr<GlyphAtlas>> atlases{};
+		std::vector<SDL_Texture*> staticTexts{};
+		std::vector<size_t> openGLStaticTexts{};
+
+		GlyphAtlas& GetAtlas(TTF_Font* font);
+	};
+}
@@ -0,0 +1,83 @@
+#include "ThreadPool.h"
+
+namespace GameNamespace
+{
+	ThreadPool::ThreadPool(int threads)
+	{
+		for (int i{ 1 }; i < threads; i++)
+		{
+			this->threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			isStopping = true;
+		}
+
+		taskReady.notify_all();
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	int ThreadPool::GetThreadCount() const
+	{
+		return (int)threads.size() + 1;
+	}
+
+	void ThreadPool::RunTask(TaskFunction function, void* task)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			taskFunction = function;
+			this->task = task;
+			runningWorkers = (int)threads.size();
+			generation++;
+		}
+
+		taskReady.notify_all();
+		function(task, 0);
+
+		std::unique_lock<std::mutex> lock{ mutex };
+		taskDone.wait(lock, [this] { return runningWorkers == 0; });
+	}
+
+	void ThreadPool::WorkerLoop(int worker)
+	{
+		long long seenGeneration{};
+
+		for (;;)
+		{
+			TaskFunction function{};
+			void* currentTask{};
+
+			{
+				std::unique_lock<std::mutex> lock{ mutex };
+				taskReady.wait(lock, [this, seenGeneration] { return isStopping || generation != seenGeneration; });
+
+				if (isStopping)
+				{
+					return;
+				}
+
+				seenGeneration = generation;
+				function = taskFunction;
+				currentTask = task;
+			}
+
+			function(currentTask, worker);
+
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				runningWorkers--;
+			}
+
+			taskDone.notify_one();
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GameNamespace
+{
+	// A fixed set of threads that run one task together. Run calls
+	// task(worker) once on every worker, the calling thread being worker 0,
+	// and returns when all of them are done. Nothing is allocated per run.
+	class ThreadPool
+	{
+	public:
+		explicit ThreadPool(int threads);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		int GetThreadCount() const;
+
+		template <typename Task>
+		void Run(Task& task)
+		{
+			RunTask(&InvokeTask<Task>, &task);
+		}
+
+	private:
+		typedef void (*TaskFunction)(void* task, int worker);
+
+		std::vector<std::thread> threads{};
+		std::mutex mutex{};
+		std::condition_variable taskReady{};
+		std::condition_variable taskDone{};
+		TaskFunction taskFunction{};
+		void* task{};
+		long long generation{};
+		int runningWorkers{};
+		bool isStopping{};
+
+		template <typename Task>
+		static void InvokeTask(void* task, int worker)
+		{
+			(*static_cast<Task*>(task))(worker);
+		}
+
+		void RunTask(TaskFunction function, void* task);
+		void WorkerLoop(int worker);
+	};
+}
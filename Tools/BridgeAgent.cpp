@@ -0,0 +1,142 @@
+// A minimal external agent: joins an AgentBridge hosted by Simulator
+// --bridge or by the game started with --bridge, answers every state with a
+// random movement and reports how many steps per second go through the
+// bridge. It closes the bridge after --steps states, which ends a headless
+// host. --actions answers every state with that many movements, like an agent
+// acting faster than the game ticks, so a host gets several inputs, no-ops
+// among them, in one tick.
+//
+// Usage: BridgeAgent NAME [--steps N] [--seed S] [--actions N]
+//
+// Built by CMakeLists.txt as the BridgeAgent target.
+
+#include "AgentBridge.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace GameNamespace;
+
+namespace
+{
+	const int JOIN_ATTEMPTS{ 500 };
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: BridgeAgent NAME [--steps N] [--seed S] [--actions N]\n";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	long long steps{ 1000000 };
+	uint64_t seed{ 1 };
+	int actionsPerState{ 1 };
+
+	if (argc < 2)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	for (int i{ 2 }; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			steps = std::atoll(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--actions") == 0 && i + 1 < argc)
+		{
+			actionsPerState = std::max(1, std::atoi(argv[++i]));
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	AgentBridge bridge{};
+
+	// The host may still be starting.
+	for (int i{}; i < JOIN_ATTEMPTS && !bridge.Join(argv[1]); i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds{ 10 });
+	}
+
+	if (!bridge.IsOpen())
+	{
+		std::cerr << "Cannot join bridge " << argv[1] << "\n";
+		return 1;
+	}
+
+	Xoshiro256 generator{ seed };
+	long long answered{}, games{}, tornStates{}, lines{};
+
+	auto start{ std::chrono::steady_clock::now() };
+
+	while (answered < steps)
+	{
+		BridgeStateData state{};
+		uint32_t sequence{};
+
+		if (!bridge.WaitForState(state, sequence))
+		{
+			break;
+		}
+
+		// A host that does not wait for actions may have reused the slot.
+		if (sequence == 0)
+		{
+			tornStates++;
+			continue;
+		}
+
+		bool isGameOver{ state.isGameOver != 0 };
+
+		lines = state.clearedLines;
+
+		games += isGameOver ? 1 : 0;
+
+		bool isSent{ true };
+
+		for (int i{}; i < (isGameOver ? 1 : actionsPerState) && isSent; i++)
+		{
+			// Speeding up as often as the other moves together, so games end.
+			uint32_t roll{ generator.NextBelow(8) };
+			BridgeAction action{ sequence, isGameOver
+				? AGENT_BRIDGE_RESET
+				: roll <= static_cast<int>(PieceMovement::SpeedUp) ? (int32_t)roll : (int32_t)PieceMovement::SpeedUp };
+
+			isSent = bridge.SendAction(action);
+		}
+
+		if (!isSent)
+		{
+			break;
+		}
+
+		answered++;
+	}
+
+	std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+	bridge.Close();
+
+	std::cout << "steps:        " << answered << "\n"
+		<< "games over:   " << games << "\n"
+		<< "last lines:   " << lines << "\n"
+		<< "torn states:  " << tornStates << "\n"
+		<< "seconds:      " << elapsed.count() << "\n"
+		<< "steps/s:      " << answered / elapsed.count() << "\n"
+		<< "round trip:   " << elapsed.count() * 1e6 / std::max(1ll, answered) << " us\n";
+
+	return 0;
+}
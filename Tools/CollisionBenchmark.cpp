@@ -0,0 +1,249 @@
+// Compares the Bitboard collision test against the cell-by-cell test that
+// Game used on std::vector<std::vector<int>> boards and nested-vector piece
+// shapes. Both are run over the same random boards and piece positions; the
+// results must agree.
+//
+// Built by CMakeLists.txt as the CollisionBenchmark target.
+
+#include "Bitboard.h"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace GameNamespace;
+
+namespace
+{
+	typedef std::vector<std::vector<int>> LegacyBoard;
+	typedef std::vector<std::vector<int>> Figure;
+	typedef std::vector<std::vector<std::vector<std::vector<int>>>> FigureContainer;
+
+	struct Position
+	{
+		int board{};
+		FigureKind figure{};
+		int rotation{};
+		int x{};
+		int y{};
+	};
+
+	const int
+		BOARDS{ 64 },
+		POSITIONS{ 1 << 16 },
+		REPETITIONS{ 100 };
+
+	FigureContainer BuildLegacyFigures()
+	{
+		FigureContainer figures(PIECE_KINDS, std::vector<Figure>(PIECE_ROTATIONS));
+
+		for (int kind{}; kind < PIECE_KINDS; kind++)
+		{
+			for (int rotation{}; rotation < PIECE_ROTATIONS; rotation++)
+			{
+				const PieceLayout& layout{ PIECE_LAYOUTS[kind][rotation] };
+				Figure& figure{ figures[kind][rotation] };
+
+				figure.assign(layout.height, std::vector<int>(layout.width));
+
+				for (const CellOffset& cell : layout.cells)
+				{
+					figure[cell.y][cell.x] = 1;
+				}
+			}
+		}
+
+		return figures;
+	}
+
+	const FigureContainer Figures{ BuildLegacyFigures() };
+
+	// The legacy loops are kept exactly as Game wrote them, comparing int
+	// indices with vector sizes.
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4018)
+#else
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+	bool IsLegacyCollision(const LegacyBoard& board, const Position& position)
+	{
+		const Figure& figure{ Figures[static_cast<int>(position.figure)][position.rotation] };
+
+		for (int i{}; i < figure.size(); i++)
+		{
+			if (position.y + i < 0)
+			{
+				continue;
+			}
+
+			for (int j{}; j < figure[i].size(); j++)
+			{
+				if (figure[i][j] != 0)
+				{
+					if (board[position.y + i][position.x + j] != 0)
+					{
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool IsInsideBoard(const Position& position)
+	{
+		const Figure& figure{ Figures[static_cast<int>(position.figure)][position.rotation] };
+
+		for (int i{}; i < figure.size(); i++)
+		{
+			for (int j{}; j < figure[i].size(); j++)
+			{
+				int x{ position.x + j }, y{ position.y + i };
+
+				if (figure[i][j] != 0
+					&& (x < 0 || x >= BOARD_WIDTH_IN_BLOCKS || y < 0 || y >= BOARD_HEIGHT_IN_BLOCKS))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#else
+#pragma GCC diagnostic pop
+#endif
+
+	void FillRandomBoard(std::mt19937& generator, LegacyBoard& legacyBoard, Bitboard& bitboard)
+	{
+		std::uniform_int_distribution<int> heightDistribution{ 0, BOARD_HEIGHT_IN_BLOCKS - 4 };
+		std::bernoulli_distribution cellDistribution{ 0.7 };
+		int stackTop{ BOARD_HEIGHT_IN_BLOCKS - 1 - heightDistribution(generator) };
+
+		legacyBoard.assign(BOARD_HEIGHT_IN_BLOCKS, std::vector<int>(BOARD_WIDTH_IN_BLOCKS));
+		bitboard.Clear();
+
+		for (int i{}; i < BOARD_HEIGHT_IN_BLOCKS; i++)
+		{
+			BoardRow row{ bitboard.GetRow(i) };
+
+			for (int j{}; j < BOARD_WIDTH_IN_BLOCKS; j++)
+			{
+				if (j == 0 || i == BOARD_HEIGHT_IN_BLOCKS - 1 || j == BOARD_WIDTH_IN_BLOCKS - 1)
+				{
+					legacyBoard[i][j] = 3;
+				}
+				else if (i >= stackTop && cellDistribution(generator))
+				{
+					legacyBoard[i][j] = 2;
+					row |= 1 << j;
+				}
+			}
+
+			bitboard.SetRow(i, row);
+		}
+	}
+
+	template <typename Check>
+	double MeasureNanosecondsPerCheck(const std::vector<Position>& positions, Check check, long long& hits)
+	{
+		auto start{ std::chrono::steady_clock::now() };
+
+		for (int repetition{}; repetition < REPETITIONS; repetition++)
+		{
+			for (const Position& position : positions)
+			{
+				hits += check(position) ? 1 : 0;
+			}
+		}
+
+		std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+
+		return elapsed.count() / ((double)positions.size() * REPETITIONS);
+	}
+}
+
+int main()
+{
+	std::mt19937 generator{ 2022 };
+	std::vector<LegacyBoard> legacyBoards(BOARDS);
+	std::vector<Bitboard> bitboards(BOARDS);
+
+	for (int i{}; i < BOARDS; i++)
+	{
+		FillRandomBoard(generator, legacyBoards[i], bitboards[i]);
+	}
+
+	std::uniform_int_distribution<int>
+		boardDistribution{ 0, BOARDS - 1 },
+		figureDistribution{ 0, PIECE_KINDS - 1 },
+		rotationDistribution{ 0, PIECE_ROTATIONS - 1 },
+		xDistribution{ MIN_PIECE_X, BOARD_WIDTH_IN_BLOCKS - 1 },
+		yDistribution{ 0, BOARD_HEIGHT_IN_BLOCKS - 1 };
+
+	std::vector<Position> positions{};
+
+	while (positions.size() < POSITIONS)
+	{
+		Position position
+		{
+			boardDistribution(generator),
+			(FigureKind)figureDistribution(generator),
+			rotationDistribution(generator),
+			xDistribution(generator),
+			yDistribution(generator)
+		};
+
+		if (IsInsideBoard(position))
+		{
+			positions.push_back(position);
+		}
+	}
+
+	for (const Position& position : positions)
+	{
+		bool legacy{ IsLegacyCollision(legacyBoards[position.board], position) };
+		bool bitboard{
+			bitboards[position.board].IsCollision(position.figure, position.rotation, position.x, position.y) };
+
+		if (legacy != bitboard)
+		{
+			std::cerr << "Mismatch: figure " << static_cast<int>(position.figure)
+				<< " rotation " << position.rotation
+				<< " at (" << position.x << ", " << position.y << ")\n";
+			return 1;
+		}
+	}
+
+	long long legacyHits{}, bitboardHits{};
+
+	double legacyTime{ MeasureNanosecondsPerCheck(positions,
+		[&](const Position& position)
+		{
+			return IsLegacyCollision(legacyBoards[position.board], position);
+		},
+		legacyHits) };
+
+	double bitboardTime{ MeasureNanosecondsPerCheck(positions,
+		[&](const Position& position)
+		{
+			return bitboards[position.board].IsCollision(
+				position.figure, position.rotation, position.x, position.y);
+		},
+		bitboardHits) };
+
+	std::cout << "positions:  " << positions.size() << " x " << REPETITIONS << "\n"
+		<< "collisions: " << legacyHits << " / " << bitboardHits << "\n"
+		<< "legacy:     " << legacyTime << " ns/check\n"
+		<< "bitboard:   " << bitboardTime << " ns/check\n"
+		<< "speedup:    " << legacyTime / bitboardTime << "x\n";
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+// Steps a VectorEnvironment with random actions and reports how many
+// environment steps it runs per second. Every game is also played on an
+// Engine of its own with the same actions, one game after another on this
+// thread, and the rewards, game overs and final boards must agree.
+//
+// Usage: EnvironmentBenchmark [--environments N] [--threads N] [--steps N]
+//                             [--seed S]
+//
+// Built by CMakeLists.txt as the EnvironmentBenchmark target.
+
+#include "VectorEnvironment.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace GameNamespace;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::cerr << "Usage: EnvironmentBenchmark [--environments N] [--threads N] [--steps N] [--seed S]\n";
+	}
+
+	// Replays the recorded actions of every game on a plain Engine and
+	// compares what it sees with the last observation and the totals.
+	long long CheckGames(const VectorEnvironment& environment, const std::vector<PieceMovement>& actions,
+		const std::vector<long long>& lines, const std::vector<long long>& gameOvers, int steps, uint64_t seed)
+	{
+		const int count{ environment.GetCount() };
+		long long mismatches{};
+
+		for (int i{}; i < count; i++)
+		{
+			Engine engine{ seed + i };
+			long long episodes{}, clearedLines{}, previousLines{};
+
+			for (int step{}; step < steps; step++)
+			{
+				engine.Tick(actions[(size_t)step * count + i]);
+				clearedLines += engine.GetClearedLines() - previousLines;
+				previousLines = engine.GetClearedLines();
+
+				if (engine.IsGameOver())
+				{
+					episodes++;
+					engine.Reset(seed + (uint64_t)episodes * count + i);
+					previousLines = 0;
+				}
+			}
+
+			bool isSame{ clearedLines == lines[i] && episodes == gameOvers[i]
+				&& engine.GetLockedPieces() == environment.GetLockedPieces(i)
+				&& engine.GetPosition().x == environment.GetPosition(i).x
+				&& engine.GetPosition().y == environment.GetPosition(i).y };
+
+			for (int y{}; y < BOARD_HEIGHT_IN_BLOCKS; y++)
+			{
+				isSame = isSame && engine.GetBoard().GetRow(y) == environment.GetBoard(i).GetRow(y);
+			}
+
+			mismatches += isSame ? 0 : 1;
+		}
+
+		return mismatches;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	int count{ 256 };
+	int threads{ std::max(1, (int)std::thread::hardware_concurrency()) };
+	int steps{ 20000 };
+	uint64_t seed{ 1 };
+
+	for (int i{ 1 }; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--environments") == 0 && i + 1 < argc)
+		{
+			count = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			threads = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			steps = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (count < 1 || threads < 1 || steps < 1)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	VectorEnvironment environment{ count, threads, seed };
+	std::vector<uint8_t> observations((size_t)count * OBSERVATION_SIZE);
+	std::vector<float> rewards(count);
+	std::vector<uint8_t> dones(count);
+	std::vector<long long> lines(count), gameOvers(count);
+	std::vector<PieceMovement> actions((size_t)steps * count);
+	Xoshiro256 generator{ seed };
+
+	// Speeding up as often as the rest together makes the stack grow fast
+	// enough to see game overs.
+	for (PieceMovement& action : actions)
+	{
+		uint32_t roll{ generator.NextBelow(ACTION_COUNT + 3) };
+
+		action = roll < ACTION_COUNT ? (PieceMovement)roll : PieceMovement::SpeedUp;
+	}
+
+	environment.Reset(observations.data());
+
+	auto start{ std::chrono::steady_clock::now() };
+
+	for (int step{}; step < steps; step++)
+	{
+		environment.Step(actions.data() + (size_t)step * count, observations.data(), rewards.data(), dones.data());
+
+		for (int i{}; i < count; i++)
+		{
+			lines[i] += (long long)rewards[i];
+			gameOvers[i] += dones[i];
+		}
+	}
+
+	std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+	long long mismatches{ CheckGames(environment, actions, lines, gameOvers, steps, seed) };
+
+	std::cout << "environments: " << count << "\n"
+		<< "threads:      " << environment.GetThreadCount() << "\n"
+		<< "steps:        " << (long long)steps * count << "\n"
+		<< "episodes:     " << environment.GetEpisodes() << "\n"
+		<< "mismatches:   " << mismatches << "\n"
+		<< "seconds:      " << elapsed.count() << "\n"
+		<< "steps/s:      " << (long long)steps * count / elapsed.count() << "\n"
+		<< "observation:  " << OBSERVATION_PLANES << "x" << OBSERVATION_ROWS << "x" << OBSERVATION_COLUMNS
+		<< " bits in " << OBSERVATION_SIZE << " bytes\n";
+
+	return mismatches == 0 ? 0 : 1;
+}
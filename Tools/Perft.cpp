@@ -0,0 +1,521 @@
+// Counts the boards reachable by placing every piece of a fixed sequence in
+// every possible way, the way perft counts chess positions. Depth N places
+// the first N pieces; boards that come out the same are counted once. Each
+// depth is run on one thread and then split across all cores, and the two
+// must agree.
+//
+// Usage: Perft [--board FILE] [--sequence PIECES] [--seed S]
+//              [--randomizer uniform|bag|history] [--depth N] [--threads N]
+//              [--search]
+//        Perft --check
+//
+// PIECES is a list of O, I, L, J, Z, S and T, each optionally followed by
+// the rotation it spawns in, e.g. "T I2 O". Without --sequence the pieces are
+// drawn from the randomizer seeded with S, as a game would spawn them. A
+// board file has one line per row, bottom row last, with # for a block and .
+// for an empty cell inside the walls.
+//
+// Placements come from PlacementGenerator::Generate, or with --search from
+// GenerateBySearch, which tests every move with Bitboard::IsCollision the
+// way Engine::MovePiece does. Pieces are locked with Bitboard::Place and
+// ClearFullRows, as in Engine. --check runs the known-answer cases below with
+// both generators.
+//
+// Built by CMakeLists.txt as the Perft target.
+
+#include "PlacementGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameNamespace;
+
+namespace
+{
+	const int
+		BOARD_INTERIOR_WIDTH{ BOARD_WIDTH_IN_BLOCKS - 2 },
+		BOARD_INTERIOR_HEIGHT{ BOARD_HEIGHT_IN_BLOCKS - 1 },
+		ROWS_PER_KEY_WORD{ 64 / BOARD_INTERIOR_WIDTH },
+		MAX_DEPTH{ 16 };
+
+	const char PIECE_LETTERS[PIECE_KINDS + 1]{ "OILJZST" };
+
+	// The cells inside the walls, ROWS_PER_KEY_WORD rows to a word.
+	typedef std::array<uint64_t, (BOARD_INTERIOR_HEIGHT + ROWS_PER_KEY_WORD - 1) / ROWS_PER_KEY_WORD> BoardKey;
+
+	struct Piece
+	{
+		FigureKind figure{};
+		size_t rotation{};
+	};
+
+	struct PerftResult
+	{
+		long long placements{};
+		std::vector<BoardKey> boards{};
+	};
+
+	struct KnownAnswer
+	{
+		const char* name;
+		const char* board;
+		const char* sequence;
+		int depth;
+		long long placements;
+		long long boards;
+	};
+
+	const char* const WELL_BOARD
+	{
+		"########.\n"
+		"########.\n"
+		"########.\n"
+		"########.\n"
+	};
+
+	const char* const OVERHANG_BOARD
+	{
+		"....#....\n"
+		"...###...\n"
+		"#.......#\n"
+		"##.....##\n"
+	};
+
+	const KnownAnswer KNOWN_ANSWERS[]
+	{
+		{ "empty O", "", "O", 1, 8, 8 },
+		{ "empty T", "", "T", 1, 30, 30 },
+		{ "empty IOT", "", "I O T", 3, 3652, 3652 },
+		{ "empty SZLJ", "", "S Z L J", 4, 234081, 233113 },
+		{ "well II", WELL_BOARD, "I I", 2, 225, 156 },
+		{ "well LI", WELL_BOARD, "L I", 2, 462, 462 },
+		{ "overhang TTJ", OVERHANG_BOARD, "T T J", 3, 22356, 22354 },
+	};
+
+	BoardKey PackBoard(const Bitboard& board)
+	{
+		BoardKey key{};
+
+		for (int i{}; i < BOARD_INTERIOR_HEIGHT; i++)
+		{
+			uint64_t cells{ (uint64_t)(board.GetRow(i) & ~WALLS_ROW_MASK & FULL_ROW_MASK) >> 1 };
+
+			key[i / ROWS_PER_KEY_WORD] |= cells << (i % ROWS_PER_KEY_WORD * BOARD_INTERIOR_WIDTH);
+		}
+
+		return key;
+	}
+
+	void UnpackBoard(const BoardKey& key, Bitboard& board)
+	{
+		const uint64_t rowMask{ (1ull << BOARD_INTERIOR_WIDTH) - 1 };
+
+		for (int i{}; i < BOARD_INTERIOR_HEIGHT; i++)
+		{
+			uint64_t cells{ key[i / ROWS_PER_KEY_WORD] >> (i % ROWS_PER_KEY_WORD * BOARD_INTERIOR_WIDTH) & rowMask };
+
+			board.SetRow(i, (BoardRow)(WALLS_ROW_MASK | cells << 1));
+		}
+	}
+
+	bool ParseBoard(const std::string& text, Bitboard& board)
+	{
+		std::vector<std::string> lines{};
+		size_t start{};
+
+		while (start < text.size())
+		{
+			size_t end{ text.find('\n', start) };
+
+			if (end == std::string::npos)
+			{
+				end = text.size();
+			}
+
+			std::string line{ text.substr(start, end - start) };
+
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+
+			if (!line.empty())
+			{
+				lines.push_back(line);
+			}
+
+			start = end + 1;
+		}
+
+		if (lines.size() > BOARD_INTERIOR_HEIGHT)
+		{
+			std::cerr << "Board has more than " << BOARD_INTERIOR_HEIGHT << " rows\n";
+			return false;
+		}
+
+		board.Clear();
+
+		for (size_t i{}; i < lines.size(); i++)
+		{
+			int y{ BOARD_INTERIOR_HEIGHT - (int)lines.size() + (int)i };
+			BoardRow row{ WALLS_ROW_MASK };
+
+			if (lines[i].size() != BOARD_INTERIOR_WIDTH)
+			{
+				std::cerr << "Board row " << i + 1 << " is not " << BOARD_INTERIOR_WIDTH << " cells wide\n";
+				return false;
+			}
+
+			for (int j{}; j < BOARD_INTERIOR_WIDTH; j++)
+			{
+				if (lines[i][j] == '#')
+				{
+					row |= 1 << (j + 1);
+				}
+				else if (lines[i][j] != '.')
+				{
+					std::cerr << "Unknown board cell '" << lines[i][j] << "'\n";
+					return false;
+				}
+			}
+
+			board.SetRow(y, row);
+		}
+
+		return true;
+	}
+
+	bool ParseSequence(const char* text, std::vector<Piece>& sequence)
+	{
+		for (const char* symbol{ text }; *symbol != '\0'; symbol++)
+		{
+			if (*symbol == ' ' || *symbol == ',')
+			{
+				continue;
+			}
+
+			const char* letter{ std::strchr(PIECE_LETTERS, *symbol) };
+
+			if (letter == nullptr)
+			{
+				std::cerr << "Unknown piece '" << *symbol << "'\n";
+				return false;
+			}
+
+			Piece piece{ (FigureKind)(letter - PIECE_LETTERS) };
+
+			if (symbol[1] >= '0' && symbol[1] < '0' + PIECE_ROTATIONS)
+			{
+				piece.rotation = *++symbol - '0';
+			}
+
+			sequence.push_back(piece);
+		}
+
+		return true;
+	}
+
+	bool ParseRandomizer(const char* name, RandomizerKind& kind)
+	{
+		if (std::strcmp(name, "uniform") == 0)
+		{
+			kind = RandomizerKind::Uniform;
+		}
+		else if (std::strcmp(name, "bag") == 0)
+		{
+			kind = RandomizerKind::SevenBag;
+		}
+		else if (std::strcmp(name, "history") == 0)
+		{
+			kind = RandomizerKind::History;
+		}
+		else
+		{
+			std::cerr << "Unknown randomizer " << name << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	// Places piece in every way on boards first, first + step, ... and
+	// collects the boards that result, sorted and without repeats.
+	void ExpandBoards(const std::vector<BoardKey>& boards, size_t first, size_t step, Piece piece, bool useSearch,
+		PerftResult& result)
+	{
+		std::unique_ptr<PlacementGenerator> generator{ std::make_unique<PlacementGenerator>() };
+		Bitboard board{}, child{};
+		PiecePosition spawnPosition{ PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW };
+
+		for (size_t i{ first }; i < boards.size(); i += step)
+		{
+			UnpackBoard(boards[i], board);
+
+			int count{ useSearch
+				? generator->GenerateBySearch(board, piece.figure, piece.rotation, spawnPosition)
+				: generator->Generate(board, piece.figure, piece.rotation, spawnPosition) };
+
+			for (int j{}; j < count; j++)
+			{
+				const Placement& placement{ generator->GetPlacement(j) };
+
+				child = board;
+				child.Place(piece.figure, placement.rotation, placement.x, placement.y);
+				child.ClearFullRows();
+				result.boards.push_back(PackBoard(child));
+			}
+
+			result.placements += count;
+		}
+
+		std::sort(result.boards.begin(), result.boards.end());
+		result.boards.erase(std::unique(result.boards.begin(), result.boards.end()), result.boards.end());
+	}
+
+	PerftResult ExpandLevel(const std::vector<BoardKey>& boards, Piece piece, int threads, bool useSearch)
+	{
+		std::vector<PerftResult> results(threads);
+		std::vector<std::thread> workers{};
+
+		for (int i{ 1 }; i < threads; i++)
+		{
+			workers.emplace_back(ExpandBoards, std::cref(boards), i, threads, piece, useSearch, std::ref(results[i]));
+		}
+
+		ExpandBoards(boards, 0, threads, piece, useSearch, results[0]);
+
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		for (int i{ 1 }; i < threads; i++)
+		{
+			size_t middle{ results[0].boards.size() };
+
+			results[0].placements += results[i].placements;
+			results[0].boards.insert(results[0].boards.end(), results[i].boards.begin(), results[i].boards.end());
+			std::inplace_merge(results[0].boards.begin(), results[0].boards.begin() + middle, results[0].boards.end());
+			results[0].boards.erase(std::unique(results[0].boards.begin(), results[0].boards.end()),
+				results[0].boards.end());
+		}
+
+		return std::move(results[0]);
+	}
+
+	// Runs every depth up to depth and returns the last one. With report set
+	// every depth is printed with its timing.
+	PerftResult RunPerft(const Bitboard& board, const std::vector<Piece>& sequence, int depth, int threads,
+		bool useSearch, bool report)
+	{
+		PerftResult result{ 0, { PackBoard(board) } };
+		double totalSeconds{};
+
+		for (int i{}; i < depth; i++)
+		{
+			auto start{ std::chrono::steady_clock::now() };
+
+			result = ExpandLevel(result.boards, sequence[i], threads, useSearch);
+
+			std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+			totalSeconds += elapsed.count();
+
+			if (report)
+			{
+				std::cout << "  depth " << i + 1
+					<< "  placements " << result.placements
+					<< "  boards " << result.boards.size()
+					<< "  seconds " << elapsed.count()
+					<< "  nodes/s " << result.placements / elapsed.count() << "\n";
+			}
+		}
+
+		if (report)
+		{
+			std::cout << "  total seconds " << totalSeconds << "\n";
+		}
+
+		return result;
+	}
+
+	int GetDefaultThreads()
+	{
+		return std::max(1, (int)std::thread::hardware_concurrency());
+	}
+
+	int RunKnownAnswers()
+	{
+		int failures{};
+		int threads{ GetDefaultThreads() };
+
+		for (const KnownAnswer& answer : KNOWN_ANSWERS)
+		{
+			Bitboard board{};
+			std::vector<Piece> sequence{};
+
+			ParseBoard(answer.board, board);
+			ParseSequence(answer.sequence, sequence);
+
+			auto start{ std::chrono::steady_clock::now() };
+
+			PerftResult results[]
+			{
+				RunPerft(board, sequence, answer.depth, 1, false, false),
+				RunPerft(board, sequence, answer.depth, threads, false, false),
+				RunPerft(board, sequence, answer.depth, threads, true, false)
+			};
+
+			std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+			bool isPassed{ true };
+
+			for (const PerftResult& result : results)
+			{
+				isPassed = isPassed
+					&& result.placements == answer.placements
+					&& (long long)result.boards.size() == answer.boards;
+			}
+
+			std::cout << (isPassed ? "ok    " : "FAIL  ") << answer.name
+				<< "  depth " << answer.depth
+				<< "  placements " << results[0].placements << " (" << answer.placements << ")"
+				<< "  boards " << results[0].boards.size() << " (" << answer.boards << ")"
+				<< "  search " << results[2].placements << "/" << results[2].boards.size()
+				<< "  seconds " << elapsed.count() << "\n";
+
+			failures += isPassed ? 0 : 1;
+		}
+
+		return failures == 0 ? 0 : 1;
+	}
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: Perft [--board FILE] [--sequence PIECES] [--seed S]"
+			" [--randomizer uniform|bag|history] [--depth N] [--threads N] [--search]\n"
+			"       Perft --check\n";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Bitboard board{};
+	std::vector<Piece> sequence{};
+	uint64_t seed{ 1 };
+	RandomizerKind randomizerKind{ RandomizerKind::Uniform };
+	int depth{ 3 };
+	int threads{ GetDefaultThreads() };
+	bool useSearch{};
+
+	for (int i{ 1 }; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--check") == 0)
+		{
+			return RunKnownAnswers();
+		}
+		else if (std::strcmp(argv[i], "--board") == 0 && i + 1 < argc)
+		{
+			std::ifstream file{ argv[++i] };
+			std::string text{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+			if (!file || !ParseBoard(text, board))
+			{
+				std::cerr << "Cannot read board " << argv[i] << "\n";
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--sequence") == 0 && i + 1 < argc)
+		{
+			if (!ParseSequence(argv[++i], sequence))
+			{
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!ParseRandomizer(argv[++i], randomizerKind))
+			{
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc)
+		{
+			depth = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			threads = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (std::strcmp(argv[i], "--search") == 0)
+		{
+			useSearch = true;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (depth < 1 || depth > MAX_DEPTH)
+	{
+		std::cerr << "Depth must be between 1 and " << MAX_DEPTH << "\n";
+		return 1;
+	}
+
+	if (sequence.empty())
+	{
+		PieceRandomizer randomizer{};
+
+		randomizer.Reset(seed, randomizerKind);
+
+		for (int i{}; i < depth; i++)
+		{
+			SpawnedPiece piece{ randomizer.Next() };
+
+			sequence.push_back({ piece.figure, (size_t)piece.rotation });
+		}
+	}
+
+	if ((int)sequence.size() < depth)
+	{
+		std::cerr << "The sequence has fewer than " << depth << " pieces\n";
+		return 1;
+	}
+
+	std::cout << "sequence:";
+
+	for (int i{}; i < depth; i++)
+	{
+		std::cout << " " << PIECE_LETTERS[static_cast<int>(sequence[i].figure)] << sequence[i].rotation;
+	}
+
+	std::cout << "\n1 thread\n";
+
+	PerftResult single{ RunPerft(board, sequence, depth, 1, useSearch, true) };
+
+	if (threads > 1)
+	{
+		std::cout << threads << " threads\n";
+
+		PerftResult parallel{ RunPerft(board, sequence, depth, threads, useSearch, true) };
+
+		if (parallel.placements != single.placements || parallel.boards != single.boards)
+		{
+			std::cerr << "The threaded run disagrees with the single threaded one\n";
+			return 1;
+		}
+	}
+
+	return 0;
+}
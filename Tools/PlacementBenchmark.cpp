@@ -0,0 +1,186 @@
+// Measures how fast PlacementGenerator enumerates placements and checks it
+// against GenerateBySearch, which tries one move at a time. Positions are
+// taken from games played with random input, right after each piece spawns.
+// Every placement's path is also replayed move by move to see that it ends
+// there.
+//
+// Built by CMakeLists.txt as the PlacementBenchmark target.
+
+#include "PlacementGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace GameNamespace;
+
+namespace
+{
+	struct Position
+	{
+		Bitboard board{};
+		FigureKind figure{};
+		size_t rotation{};
+		PiecePosition position{};
+	};
+
+	const int
+		POSITIONS{ 4096 },
+		REPETITIONS{ 200 };
+
+	std::vector<Position> CollectPositions()
+	{
+		std::vector<Position> positions{};
+		Xoshiro256 inputGenerator{ 7 };
+		Engine engine{ 1 };
+		long long lockedPieces{ -1 };
+		uint64_t games{ 1 };
+
+		while (positions.size() < POSITIONS)
+		{
+			if (engine.GetLockedPieces() != lockedPieces)
+			{
+				lockedPieces = engine.GetLockedPieces();
+				positions.push_back({ engine.GetBoard(), engine.GetCurrentFigure(), engine.GetRotation(),
+					engine.GetPosition() });
+			}
+
+			engine.Tick((PieceMovement)inputGenerator.NextBelow(static_cast<int>(PieceMovement::SpeedUp) + 1));
+
+			if (engine.IsGameOver())
+			{
+				engine.Reset(1 + games++);
+				lockedPieces = -1;
+			}
+		}
+
+		return positions;
+	}
+
+	int GetKey(int rotation, int x, int y)
+	{
+		return (rotation * PIECE_X_POSITIONS + x - MIN_PIECE_X) * BOARD_HEIGHT_IN_BLOCKS + y;
+	}
+
+	std::vector<int> GetSortedPlacements(const PlacementGenerator& generator)
+	{
+		std::vector<int> placements{};
+
+		for (int i{}; i < generator.GetCount(); i++)
+		{
+			const Placement& placement{ generator.GetPlacement(i) };
+
+			placements.push_back(GetKey(placement.rotation, placement.x, placement.y));
+		}
+
+		std::sort(placements.begin(), placements.end());
+
+		return placements;
+	}
+
+	bool IsPathCorrect(const Position& position, const Placement& placement, const PieceMovement* path, int length)
+	{
+		int x{ position.position.x }, y{ position.position.y }, rotation{ (int)position.rotation };
+
+		for (int i{}; i < length - 1; i++)
+		{
+			int nextX{ x }, nextY{ y }, nextRotation{ rotation };
+
+			switch (path[i])
+			{
+			case PieceMovement::Left:
+				nextX--;
+				break;
+
+			case PieceMovement::Right:
+				nextX++;
+				break;
+
+			case PieceMovement::Rotation:
+				nextRotation = (rotation + 1) % PIECE_ROTATIONS;
+				nextX = Engine::CalculateRotatedX(position.figure, nextRotation, x);
+				break;
+
+			default:
+				nextY++;
+				break;
+			}
+
+			if (position.board.IsCollision(position.figure, nextRotation, nextX, nextY))
+			{
+				return false;
+			}
+
+			x = nextX;
+			y = nextY;
+			rotation = nextRotation;
+		}
+
+		return path[length - 1] == PieceMovement::SpeedUp
+			&& x == placement.x && y == placement.y
+			&& CANONICAL_ROTATIONS[static_cast<int>(position.figure)][rotation] == placement.rotation
+			&& position.board.IsCollision(position.figure, rotation, x, y + 1);
+	}
+}
+
+int main()
+{
+	std::vector<Position> positions{ CollectPositions() };
+	PlacementGenerator generator{}, reference{};
+	PieceMovement path[MAX_PLACEMENT_PATH]{};
+	long long placements{}, pathMovements{};
+
+	for (const Position& position : positions)
+	{
+		reference.GenerateBySearch(position.board, position.figure, position.rotation, position.position);
+		generator.Generate(position.board, position.figure, position.rotation, position.position);
+
+		for (int i{}; i < generator.GetCount(); i++)
+		{
+			const Placement& placement{ generator.GetPlacement(i) };
+			int length{ generator.FindPath(position.board, position.figure, position.rotation, position.position,
+				placement, path, MAX_PLACEMENT_PATH) };
+
+			if (length < 0 || !IsPathCorrect(position, placement, path, length))
+			{
+				std::cerr << "No path to placement (" << placement.x << ", " << placement.y
+					<< ") rotation " << placement.rotation << "\n";
+				return 1;
+			}
+
+			pathMovements += length;
+		}
+
+		if (GetSortedPlacements(generator) != GetSortedPlacements(reference))
+		{
+			std::cerr << "Mismatch: figure " << static_cast<int>(position.figure) << " generated "
+				<< generator.GetCount() << " placements, search found " << reference.GetCount() << "\n";
+			return 1;
+		}
+
+		placements += generator.GetCount();
+	}
+
+	long long checksum{};
+	auto start{ std::chrono::steady_clock::now() };
+
+	for (int repetition{}; repetition < REPETITIONS; repetition++)
+	{
+		for (const Position& position : positions)
+		{
+			checksum += generator.Generate(position.board, position.figure, position.rotation, position.position);
+		}
+	}
+
+	std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+	double generated{ (double)positions.size() * REPETITIONS };
+
+	std::cout << "positions:      " << positions.size() << " x " << REPETITIONS << "\n"
+		<< "placements:     " << (double)placements / positions.size() << " per position\n"
+		<< "path length:    " << (double)pathMovements / placements << " movements\n"
+		<< "checksum:       " << checksum << "\n"
+		<< "positions/s:    " << generated / elapsed.count() << "\n"
+		<< "ns/position:    " << elapsed.count() * 1e9 / generated << "\n";
+
+	return 0;
+}
@@ -0,0 +1,528 @@
+// Plays the game headless as fast as possible, feeding the engine either a
+// scripted input sequence, random input or the bot's input, and reports
+// throughput. --beam makes the bot use a beam search on that many threads,
+// with a transposition table of --table megabytes (0 for none).
+// --bridge hosts an AgentBridge under NAME and waits for the agent's action
+// every tick instead, applying in that tick every action that has arrived by
+// then, as the game does; it stops when the agent leaves.
+//
+// Usage: Simulator [--pieces N] [--seed S] [--randomizer uniform|bag|history]
+//                  [--script FILE] [--bot] [--beam THREADS] [--table MB]
+//                  [--record FILE] [--bridge NAME] [--check]
+//        Simulator --replay FILE...
+//
+// Game N of a run is seeded with S + N, so a run is fully reproducible.
+// Through the bridge the agent sees the final state of a game, and its
+// answer to it, or an AGENT_BRIDGE_RESET at any time, starts the next game.
+// --record saves the first game of the run as a replay, cut off where the run
+// stops if that game is not over by then. --replay re-simulates
+// replays at full speed and checks each against the result it recorded.
+// A script is a text file with one character per logic tick: L and R move
+// the piece, U rotates it, D speeds it up, H drops it and . does nothing.
+// Whitespace is ignored and the script repeats until enough pieces have been
+// locked.
+// --check rebuilds the engine's BoardProfile from the board after every
+// locked piece and compares it with the one kept up to date, and rehashes
+// the board and the falling piece every tick and compares the hash with the
+// one kept up to date. With --record it also replays the saved game and
+// compares the result with the live one.
+
+#include "AgentBridge.h"
+#include "Bot.h"
+#include "Evaluation.h"
+#include "Engine.h"
+#include "InputQueue.h"
+#include "Replay.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace GameNamespace;
+
+namespace
+{
+	bool ParseScript(const char* path, std::vector<PieceMovement>& script)
+	{
+		std::ifstream file{ path };
+
+		if (!file)
+		{
+			std::cerr << "Cannot open script " << path << "\n";
+			return false;
+		}
+
+		char symbol{};
+
+		while (file.get(symbol))
+		{
+			switch (symbol)
+			{
+			case 'L':
+				script.push_back(PieceMovement::Left);
+				break;
+
+			case 'R':
+				script.push_back(PieceMovement::Right);
+				break;
+
+			case 'U':
+				script.push_back(PieceMovement::Rotation);
+				break;
+
+			case 'D':
+				script.push_back(PieceMovement::SpeedUp);
+				break;
+
+			case 'H':
+				script.push_back(PieceMovement::HardDrop);
+				break;
+
+			case '.':
+				script.push_back(PieceMovement::None);
+				break;
+
+			case ' ':
+			case '\t':
+			case '\r':
+			case '\n':
+				break;
+
+			default:
+				std::cerr << "Unknown script symbol '" << symbol << "'\n";
+				return false;
+			}
+		}
+
+		if (script.empty())
+		{
+			std::cerr << "Script " << path << " is empty\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ParseRandomizer(const char* name, RandomizerKind& kind)
+	{
+		if (std::strcmp(name, "uniform") == 0)
+		{
+			kind = RandomizerKind::Uniform;
+		}
+		else if (std::strcmp(name, "bag") == 0)
+		{
+			kind = RandomizerKind::SevenBag;
+		}
+		else if (std::strcmp(name, "history") == 0)
+		{
+			kind = RandomizerKind::History;
+		}
+		else
+		{
+			std::cerr << "Unknown randomizer " << name << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	int AuditReplays(const std::vector<const char*>& paths)
+	{
+		ReplayPlayer player{};
+		Engine engine{};
+		long long ticks{}, pieces{}, mismatches{};
+
+		auto start{ std::chrono::steady_clock::now() };
+
+		for (const char* path : paths)
+		{
+			if (!player.Load(path))
+			{
+				std::cerr << path << ": cannot be loaded\n";
+				mismatches++;
+				continue;
+			}
+
+			ReplaySummary recorded{ player.GetSummary() };
+			ReplaySummary replayed{ player.Simulate(engine) };
+
+			if (replayed.score != recorded.score || replayed.lockedPieces != recorded.lockedPieces)
+			{
+				std::cerr << path << ": recorded score " << recorded.score
+					<< " and " << recorded.lockedPieces << " pieces, replayed score " << replayed.score
+					<< " and " << replayed.lockedPieces << " pieces\n";
+				mismatches++;
+			}
+
+			ticks += replayed.ticks;
+			pieces += replayed.lockedPieces;
+		}
+
+		std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+		std::cout << "replays:      " << paths.size() << "\n"
+			<< "mismatches:   " << mismatches << "\n"
+			<< "pieces:       " << pieces << "\n"
+			<< "seconds:      " << elapsed.count() << "\n"
+			<< "replays/s:    " << paths.size() / elapsed.count() << "\n"
+			<< "ticks/s:      " << ticks / elapsed.count() << "\n";
+
+		return mismatches == 0 ? 0 : 1;
+	}
+
+	bool IsProfileConsistent(const Engine& engine)
+	{
+		const BoardProfile& profile{ engine.GetProfile() };
+		BoardProfile rebuilt{};
+
+		rebuilt.Reset(engine.GetBoard());
+
+		bool isConsistent{ profile.GetHoles() == rebuilt.GetHoles() && profile.HasFullRows() == rebuilt.HasFullRows() };
+
+		for (int x{}; x < BOARD_WIDTH_IN_BLOCKS; x++)
+		{
+			isConsistent = isConsistent
+				&& profile.GetHeight(x) == rebuilt.GetHeight(x)
+				&& profile.GetColumnBlocks(x) == rebuilt.GetColumnBlocks(x);
+		}
+
+		for (int y{}; y < BOARD_FLOOR_ROW; y++)
+		{
+			isConsistent = isConsistent && profile.GetRowBlocks(y) == rebuilt.GetRowBlocks(y);
+		}
+
+		BoardFeatures scanned{ CalculateBoardFeatures(engine.GetBoard()) };
+		BoardFeatures tracked{ CalculateBoardFeatures(profile) };
+
+		return isConsistent
+			&& scanned.aggregateHeight == tracked.aggregateHeight
+			&& scanned.holes == tracked.holes
+			&& scanned.bumpiness == tracked.bumpiness
+			&& scanned.wells == tracked.wells;
+	}
+
+	bool IsHashConsistent(const Engine& engine)
+	{
+		const Bitboard& board{ engine.GetBoard() };
+		PiecePosition position{ engine.GetPosition() };
+		uint64_t hash{ GetPieceHash(engine.GetCurrentFigure(), engine.GetRotation(), position.x, position.y) };
+
+		for (int y{}; y < BOARD_FLOOR_ROW; y++)
+		{
+			for (int x{}; x < BOARD_WIDTH_IN_BLOCKS; x++)
+			{
+				hash ^= board.IsBlock(x, y) ? ZOBRIST_KEYS.cells[y][x] : 0;
+			}
+		}
+
+		return hash == engine.GetHash();
+	}
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: Simulator [--pieces N] [--seed S] [--randomizer uniform|bag|history]"
+			" [--script FILE] [--bot] [--beam THREADS] [--table MB] [--record FILE] [--bridge NAME] [--check]\n"
+			"       Simulator --replay FILE...\n";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	long long pieces{ 100000 };
+	uint64_t seed{ 1 };
+	RandomizerKind randomizerKind{ RandomizerKind::Uniform };
+	std::vector<PieceMovement> script{};
+	std::vector<const char*> replays{};
+	const char* recordPath{};
+	const char* bridgeName{};
+	bool isBotPlaying{};
+	bool isChecking{};
+	int searchThreads{};
+	size_t transpositionMegabytes{ TRANSPOSITION_TABLE_MEGABYTES };
+
+	for (int i{ 1 }; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--pieces") == 0 && i + 1 < argc)
+		{
+			pieces = std::atoll(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!ParseRandomizer(argv[++i], randomizerKind))
+			{
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc)
+		{
+			if (!ParseScript(argv[++i], script))
+			{
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--check") == 0)
+		{
+			isChecking = true;
+		}
+		else if (std::strcmp(argv[i], "--bot") == 0)
+		{
+			isBotPlaying = true;
+		}
+		else if (std::strcmp(argv[i], "--beam") == 0 && i + 1 < argc)
+		{
+			isBotPlaying = true;
+			searchThreads = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (std::strcmp(argv[i], "--table") == 0 && i + 1 < argc)
+		{
+			transpositionMegabytes = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			recordPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--bridge") == 0 && i + 1 < argc)
+		{
+			bridgeName = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+		{
+			replays.assign(argv + i + 1, argv + argc);
+			break;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (!replays.empty())
+	{
+		return AuditReplays(replays);
+	}
+
+	Xoshiro256 inputGenerator{ ~seed };
+	Engine engine{ seed, randomizerKind };
+	long long lockedPieces{}, clearedLines{}, ticks{}, games{ 1 }, totalScore{};
+	long long checkedBoardVersion{ -1 }, profileMismatches{}, hashMismatches{}, replayMismatches{};
+	std::array<PieceMovement, INPUT_QUEUE_CAPACITY> movements{};
+	ReplayRecorder recorder{};
+	Bot bot{ {}, std::chrono::microseconds{ BOT_THINKING_BUDGET_MICROSECONDS }, searchThreads, transpositionMegabytes };
+
+	AgentBridge bridge{};
+
+	if (bridgeName != nullptr && !bridge.Host(bridgeName))
+	{
+		std::cerr << "Cannot host bridge " << bridgeName << "\n";
+		return 1;
+	}
+
+	if (recordPath != nullptr)
+	{
+		recorder.Begin(seed, randomizerKind);
+	}
+
+	auto saveReplay
+	{
+		[&]()
+		{
+			if (!recorder.IsRecording())
+			{
+				return true;
+			}
+
+			recorder.Finish(engine.GetScore(), engine.GetLockedPieces());
+
+			if (!recorder.Save(recordPath))
+			{
+				std::cerr << "Cannot save replay " << recordPath << "\n";
+				return false;
+			}
+
+			if (isChecking)
+			{
+				ReplayPlayer player{};
+				Engine replayEngine{};
+
+				if (!player.Load(recordPath))
+				{
+					std::cerr << "Cannot load replay " << recordPath << "\n";
+					return false;
+				}
+
+				ReplaySummary replayed{ player.Simulate(replayEngine) };
+
+				if (replayed.score != engine.GetScore() || replayed.lockedPieces != engine.GetLockedPieces())
+				{
+					std::cerr << recordPath << ": played score " << engine.GetScore()
+						<< " and " << engine.GetLockedPieces() << " pieces, replayed score " << replayed.score
+						<< " and " << replayed.lockedPieces << " pieces\n";
+					replayMismatches++;
+				}
+			}
+
+			return true;
+		}
+	};
+
+	auto finishGame
+	{
+		[&]()
+		{
+			if (!saveReplay())
+			{
+				return false;
+			}
+
+			lockedPieces += engine.GetLockedPieces();
+			clearedLines += engine.GetClearedLines();
+			totalScore += engine.GetScore();
+
+			engine.Reset(seed + games, randomizerKind);
+			games++;
+
+			return true;
+		}
+	};
+
+	auto start{ std::chrono::steady_clock::now() };
+
+	while (lockedPieces + engine.GetLockedPieces() < pieces)
+	{
+		PieceMovement movement{};
+
+		if (bridge.IsOpen())
+		{
+			BridgeAction action{};
+			int count{};
+
+			bridge.PublishState(engine, games);
+
+			if (!bridge.WaitForAction(action))
+			{
+				break;
+			}
+
+			do
+			{
+				if (engine.IsGameOver() || action.movement == AGENT_BRIDGE_RESET)
+				{
+					if (!finishGame())
+					{
+						return 1;
+					}
+
+					count = 0;
+				}
+				else if (GetBridgeMovement(action, movement) && count < INPUT_QUEUE_CAPACITY)
+				{
+					movements[count++] = movement;
+				}
+			} while (bridge.TryReceiveAction(action));
+
+			engine.Tick(movements.data(), count);
+
+			for (int i{}; i < count; i++)
+			{
+				recorder.Record(movements[i]);
+			}
+		}
+		else
+		{
+			movement = isBotPlaying
+				? bot.GetNextMovement(engine)
+				: script.empty()
+				? (PieceMovement)inputGenerator.NextBelow(static_cast<int>(PieceMovement::SpeedUp) + 1)
+				: script[ticks % script.size()];
+
+			engine.Tick(movement);
+			recorder.Record(movement);
+		}
+
+		ticks++;
+		recorder.EndTick();
+
+		if (isChecking && engine.GetBoardVersion() != checkedBoardVersion)
+		{
+			checkedBoardVersion = engine.GetBoardVersion();
+			profileMismatches += IsProfileConsistent(engine) ? 0 : 1;
+		}
+
+		if (isChecking)
+		{
+			hashMismatches += IsHashConsistent(engine) ? 0 : 1;
+		}
+
+		if (engine.IsGameOver() && !bridge.IsOpen() && !finishGame())
+		{
+			return 1;
+		}
+	}
+
+	std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+	if (!saveReplay())
+	{
+		return 1;
+	}
+
+	lockedPieces += engine.GetLockedPieces();
+	clearedLines += engine.GetClearedLines();
+	totalScore += engine.GetScore();
+
+	std::cout << "games:        " << games << "\n"
+		<< "pieces:       " << lockedPieces << "\n"
+		<< "lines:        " << clearedLines << "\n"
+		<< "ticks:        " << ticks << "\n"
+		<< "avg score:    " << (double)totalScore / games << "\n"
+		<< "seconds:      " << elapsed.count() << "\n"
+		<< "pieces/s:     " << lockedPieces / elapsed.count() << "\n"
+		<< "ticks/s:      " << ticks / elapsed.count() << "\n";
+
+	if (isChecking)
+	{
+		std::cout << "profile mismatches: " << profileMismatches << "\n"
+			<< "hash mismatches:    " << hashMismatches << "\n";
+	}
+
+	if (isBotPlaying)
+	{
+		std::cout << "over budget:  " << bot.GetOverBudgetPieces() << " of " << bot.GetPlannedPieces() << " pieces\n"
+			<< "longest plan: " << bot.GetLongestPlan().count() << " us\n";
+	}
+
+	if (bot.GetBeamSearch() != nullptr)
+	{
+		const BeamSearchStatistics& statistics{ bot.GetBeamSearch()->GetStatistics() };
+
+		std::cout << "beam nodes/s: " << statistics.GetNodesPerSecond() << "\n"
+			<< "beam levels:  " << statistics.GetAverageLevels() << " per piece\n"
+			<< "beam size:    " << statistics.GetAverageBeamSize() << " boards expanded per piece\n"
+			<< "deadline hit: " << statistics.deadlineHits << " of " << statistics.searches << " searches\n";
+
+		if (const TranspositionTable* table{ bot.GetBeamSearch()->GetTranspositionTable() })
+		{
+			std::cout << "table:        " << table->GetMemoryBytes() / (1024 * 1024) << " MB, "
+				<< table->GetEntryCount() << " entries\n"
+				<< "table hits:   " << statistics.GetTranspositionHitRate() * 100 << "% of "
+				<< statistics.transpositionProbes << " probes\n";
+		}
+	}
+
+	if (isChecking && recordPath != nullptr)
+	{
+		std::cout << "replay mismatches:  " << replayMismatches << "\n";
+	}
+
+	return profileMismatches == 0 && hashMismatches == 0 && replayMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,713 @@
+// Tunes the bot's evaluation weights by playing many games per candidate.
+//
+// Usage: Tuner [--generations N] [--population N] [--elites N] [--games N]
+//              [--round N] [--pieces N] [--cutoff F] [--seed S]
+//              [--randomizer uniform|bag|history] [--threads N] [--lookahead]
+//              [--checkpoint FILE]
+//
+// Each generation draws a population of weight vectors from a normal
+// distribution with its own spread per weight, plays the same games with all
+// of them and moves the distribution to the best few (the elites), weighted
+// by rank. Weight vectors are kept at unit length, as only the direction
+// changes which placement the bot picks.
+//
+// A game places pieces where Bot's PlacementChooser puts them, without a
+// deadline, until the stack tops out or --pieces pieces are placed, and
+// scores the lines it cleared. Game N of generation G is seeded with
+// S + G * games + N for every candidate, so candidates are compared on the
+// same pieces. Games are played in rounds of --round games; after a round,
+// candidates whose average is below --cutoff times the elites' worst average
+// play no further games. The games of a round are spread over all threads,
+// the calling thread included.
+//
+// With --checkpoint the distribution and the best weights found are written
+// to FILE after every generation, and a run started with an existing FILE
+// goes on with the generation after the saved one.
+//
+// Built by CMakeLists.txt as the Tuner target.
+
+#include "Bot.h"
+#include "Evaluation.h"
+#include "Randomizer.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameNamespace;
+
+namespace
+{
+	const int WEIGHT_COUNT{ 5 };
+
+	const double
+		INITIAL_SPREAD{ 0.2 },
+		MIN_SPREAD{ 0.005 },
+		SPREAD_SMOOTHING{ 0.7 };
+
+	const char* const CHECKPOINT_HEADER{ "tuner-checkpoint 1" };
+
+	typedef std::array<double, WEIGHT_COUNT> WeightVector;
+
+	struct Candidate
+	{
+		WeightVector weights{};
+		long long lines{};
+		long long pieces{};
+		int games{};
+		bool isDropped{};
+
+		double GetFitness() const
+		{
+			return games > 0 ? (double)lines / games : 0;
+		}
+	};
+
+	struct TunerSettings
+	{
+		int generations{ 20 };
+		int population{ 64 };
+		int elites{ 16 };
+		int games{ 32 };
+		int round{ 8 };
+		int pieces{ 1000 };
+		double cutoff{ 0.5 };
+		uint64_t seed{ 1 };
+		RandomizerKind randomizerKind{ RandomizerKind::Uniform };
+		int threads{};
+		bool useLookahead{};
+		const char* checkpointPath{};
+	};
+
+	struct TunerState
+	{
+		int generation{};
+		WeightVector mean{};
+		WeightVector spread{};
+		WeightVector bestWeights{};
+		double bestFitness{ -1 };
+		std::vector<Candidate> population{};
+	};
+
+	struct GameResult
+	{
+		long long lines{};
+		long long pieces{};
+	};
+
+	// Everything one thread needs to play games.
+	struct Worker
+	{
+		PlacementChooser chooser{};
+		long long games{};
+		double busySeconds{};
+	};
+
+	WeightVector ToVector(const EvaluationWeights& weights)
+	{
+		return { weights.aggregateHeight, weights.holes, weights.bumpiness, weights.wells, weights.clearedLines };
+	}
+
+	EvaluationWeights ToWeights(const WeightVector& vector)
+	{
+		return { vector[0], vector[1], vector[2], vector[3], vector[4] };
+	}
+
+	void Normalize(WeightVector& vector)
+	{
+		double length{};
+
+		for (double weight : vector)
+		{
+			length += weight * weight;
+		}
+
+		length = std::sqrt(length);
+
+		if (length > 0)
+		{
+			for (double& weight : vector)
+			{
+				weight /= length;
+			}
+		}
+	}
+
+	// Box-Muller; one of the pair is thrown away to keep it simple.
+	double NextNormal(Xoshiro256& generator)
+	{
+		const double pi{ 3.14159265358979323846 };
+		double first{ ((generator.Next() >> 11) + 1) * 0x1.0p-53 };
+		double second{ (generator.Next() >> 11) * 0x1.0p-53 };
+
+		return std::sqrt(-2 * std::log(first)) * std::cos(2 * pi * second);
+	}
+
+	uint64_t GetGameSeed(const TunerSettings& settings, int generation, int game)
+	{
+		return settings.seed + (uint64_t)generation * settings.games + game;
+	}
+
+	GameResult PlayGame(Worker& worker, const TunerSettings& settings, uint64_t seed, const EvaluationWeights& weights)
+	{
+		PieceRandomizer randomizer{ seed, settings.randomizerKind };
+		Bitboard board{};
+		GameResult result{};
+		SpawnedPiece current{ randomizer.Next() };
+
+		while (result.pieces < settings.pieces)
+		{
+			SpawnedPiece next{ randomizer.Next() };
+			Placement placement{};
+
+			if (!worker.chooser.Choose(board, current.figure, current.rotation,
+				{ PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW }, settings.useLookahead ? &next : nullptr, weights,
+				std::chrono::steady_clock::time_point::max(), placement))
+			{
+				break;
+			}
+
+			board.Place(current.figure, placement.rotation, placement.x, placement.y);
+			result.lines += board.ClearFullRows().count;
+			result.pieces++;
+			current = next;
+		}
+
+		return result;
+	}
+
+	std::vector<Candidate> SamplePopulation(const TunerSettings& settings, const TunerState& state)
+	{
+		Xoshiro256 generator{ settings.seed * 0x9E3779B97F4A7C15ull + state.generation };
+		std::vector<Candidate> population(settings.population);
+
+		// The current mean always takes part, so a generation never loses it.
+		population[0].weights = state.mean;
+
+		for (int i{ 1 }; i < settings.population; i++)
+		{
+			for (int j{}; j < WEIGHT_COUNT; j++)
+			{
+				population[i].weights[j] = state.mean[j] + state.spread[j] * NextNormal(generator);
+			}
+
+			Normalize(population[i].weights);
+		}
+
+		return population;
+	}
+
+	// The worst average among the best settings.elites candidates still
+	// playing.
+	double GetEliteThreshold(const TunerSettings& settings, const std::vector<Candidate>& population)
+	{
+		std::vector<double> fitness{};
+
+		for (const Candidate& candidate : population)
+		{
+			if (!candidate.isDropped)
+			{
+				fitness.push_back(candidate.GetFitness());
+			}
+		}
+
+		int elites{ std::min(settings.elites, (int)fitness.size()) };
+
+		std::nth_element(fitness.begin(), fitness.begin() + elites - 1, fitness.end(), std::greater<double>());
+
+		return fitness[elites - 1];
+	}
+
+	void UpdateDistribution(const TunerSettings& settings, TunerState& state)
+	{
+		std::vector<Candidate>& population{ state.population };
+
+		std::sort(population.begin(), population.end(),
+			[](const Candidate& first, const Candidate& second)
+			{
+				if (first.isDropped != second.isDropped)
+				{
+					return second.isDropped;
+				}
+
+				return first.GetFitness() > second.GetFitness();
+			});
+
+		if (population[0].GetFitness() > state.bestFitness)
+		{
+			state.bestFitness = population[0].GetFitness();
+			state.bestWeights = population[0].weights;
+		}
+
+		// Log rank weights, as in CMA-ES.
+		std::vector<double> rankWeights(settings.elites);
+		double rankWeightSum{};
+
+		for (int i{}; i < settings.elites; i++)
+		{
+			rankWeights[i] = std::log(settings.elites + 0.5) - std::log(i + 1.0);
+			rankWeightSum += rankWeights[i];
+		}
+
+		WeightVector mean{}, variance{};
+
+		for (int i{}; i < settings.elites; i++)
+		{
+			for (int j{}; j < WEIGHT_COUNT; j++)
+			{
+				double offset{ population[i].weights[j] - state.mean[j] };
+
+				mean[j] += rankWeights[i] / rankWeightSum * population[i].weights[j];
+				variance[j] += rankWeights[i] / rankWeightSum * offset * offset;
+			}
+		}
+
+		for (int j{}; j < WEIGHT_COUNT; j++)
+		{
+			state.spread[j] = std::max(MIN_SPREAD,
+				SPREAD_SMOOTHING * state.spread[j] + (1 - SPREAD_SMOOTHING) * std::sqrt(variance[j]));
+		}
+
+		Normalize(mean);
+		state.mean = mean;
+	}
+
+	void WriteVector(std::ostream& stream, const WeightVector& vector)
+	{
+		for (double weight : vector)
+		{
+			stream << " " << weight;
+		}
+	}
+
+	bool ReadVector(std::istream& stream, WeightVector& vector)
+	{
+		for (double& weight : vector)
+		{
+			stream >> weight;
+		}
+
+		return (bool)stream;
+	}
+
+	// Written to a temporary file first, so an interrupted run never leaves
+	// a broken checkpoint behind.
+	bool SaveCheckpoint(const char* path, const TunerState& state)
+	{
+		std::string temporaryPath{ std::string{ path } + ".tmp" };
+
+		{
+			std::ofstream file{ temporaryPath };
+
+			if (!file)
+			{
+				std::cerr << "Cannot write checkpoint " << temporaryPath << "\n";
+				return false;
+			}
+
+			file.precision(17);
+			file << CHECKPOINT_HEADER << "\n"
+				<< "generation " << state.generation << "\n"
+				<< "mean";
+			WriteVector(file, state.mean);
+			file << "\nspread";
+			WriteVector(file, state.spread);
+			file << "\nbest " << state.bestFitness;
+			WriteVector(file, state.bestWeights);
+			file << "\n";
+
+			if (!file)
+			{
+				std::cerr << "Cannot write checkpoint " << temporaryPath << "\n";
+				return false;
+			}
+		}
+
+		if (std::rename(temporaryPath.c_str(), path) != 0)
+		{
+			std::cerr << "Cannot replace checkpoint " << path << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	bool LoadCheckpoint(const char* path, TunerState& state)
+	{
+		std::ifstream file{ path };
+		std::string header{}, name{};
+
+		std::getline(file, header);
+
+		if (header != CHECKPOINT_HEADER)
+		{
+			std::cerr << path << " is not a tuner checkpoint\n";
+			return false;
+		}
+
+		file >> name >> state.generation;
+		file >> name;
+		ReadVector(file, state.mean);
+		file >> name;
+		ReadVector(file, state.spread);
+		file >> name >> state.bestFitness;
+		ReadVector(file, state.bestWeights);
+
+		if (!file)
+		{
+			std::cerr << path << " is damaged\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ParseRandomizer(const char* name, RandomizerKind& kind)
+	{
+		if (std::strcmp(name, "uniform") == 0)
+		{
+			kind = RandomizerKind::Uniform;
+		}
+		else if (std::strcmp(name, "bag") == 0)
+		{
+			kind = RandomizerKind::SevenBag;
+		}
+		else if (std::strcmp(name, "history") == 0)
+		{
+			kind = RandomizerKind::History;
+		}
+		else
+		{
+			std::cerr << "Unknown randomizer " << name << "\n";
+			return false;
+		}
+
+		return true;
+	}
+
+	void PrintUsage()
+	{
+		std::cerr << "Usage: Tuner [--generations N] [--population N] [--elites N] [--games N]"
+			" [--round N] [--pieces N] [--cutoff F] [--seed S]"
+			" [--randomizer uniform|bag|history] [--threads N] [--lookahead] [--checkpoint FILE]\n";
+	}
+
+	class Tuner
+	{
+	public:
+		Tuner(const TunerSettings& settings)
+			: settings{ settings }, pool{ settings.threads }
+		{
+			for (int i{}; i < pool.GetThreadCount(); i++)
+			{
+				workers.push_back(std::make_unique<Worker>());
+			}
+
+			jobs.reserve((size_t)settings.population * settings.round);
+			results.resize(jobs.capacity());
+		}
+
+		// Plays every game of the generation and returns the number of games
+		// played.
+		long long EvaluatePopulation(TunerState& state)
+		{
+			std::vector<Candidate>& population{ state.population };
+			long long games{};
+
+			for (int firstGame{}; firstGame < settings.games; firstGame += settings.round)
+			{
+				int lastGame{ std::min(settings.games, firstGame + settings.round) };
+
+				jobs.clear();
+
+				for (int i{}; i < (int)population.size(); i++)
+				{
+					for (int game{ firstGame }; game < lastGame && !population[i].isDropped; game++)
+					{
+						jobs.push_back({ i, game });
+					}
+				}
+
+				PlayJobs(state);
+
+				for (size_t i{}; i < jobs.size(); i++)
+				{
+					Candidate& candidate{ population[jobs[i].candidate] };
+
+					candidate.lines += results[i].lines;
+					candidate.pieces += results[i].pieces;
+					candidate.games++;
+				}
+
+				games += jobs.size();
+
+				if (lastGame < settings.games)
+				{
+					double threshold{ GetEliteThreshold(settings, population) };
+
+					for (Candidate& candidate : population)
+					{
+						candidate.isDropped = candidate.isDropped || candidate.GetFitness() < settings.cutoff * threshold;
+					}
+				}
+			}
+
+			return games;
+		}
+
+		double GetBusySeconds() const
+		{
+			double seconds{};
+
+			for (const std::unique_ptr<Worker>& worker : workers)
+			{
+				seconds += worker->busySeconds;
+			}
+
+			return seconds;
+		}
+
+		int GetThreadCount() const
+		{
+			return pool.GetThreadCount();
+		}
+
+	private:
+		struct Job
+		{
+			int candidate{};
+			int game{};
+		};
+
+		TunerSettings settings{};
+		ThreadPool pool;
+		std::vector<std::unique_ptr<Worker>> workers{};
+		std::vector<Job> jobs{};
+		std::vector<GameResult> results{};
+		std::atomic<int> nextJob{};
+
+		void PlayJobs(const TunerState& state)
+		{
+			nextJob = 0;
+
+			auto task
+			{
+				[&](int workerIndex)
+				{
+					Worker& worker{ *workers[workerIndex] };
+					auto start{ std::chrono::steady_clock::now() };
+
+					for (;;)
+					{
+						int i{ nextJob.fetch_add(1, std::memory_order_relaxed) };
+
+						if (i >= (int)jobs.size())
+						{
+							break;
+						}
+
+						const Job& job{ jobs[i] };
+
+						results[i] = PlayGame(worker, settings, GetGameSeed(settings, state.generation, job.game),
+							ToWeights(state.population[job.candidate].weights));
+						worker.games++;
+					}
+
+					worker.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				}
+			};
+
+			pool.Run(task);
+		}
+	};
+}
+
+int main(int argc, char* argv[])
+{
+	TunerSettings settings{};
+	bool isElitesSet{};
+
+	settings.threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+	for (int i{ 1 }; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--generations") == 0 && i + 1 < argc)
+		{
+			settings.generations = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--population") == 0 && i + 1 < argc)
+		{
+			settings.population = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--elites") == 0 && i + 1 < argc)
+		{
+			settings.elites = std::atoi(argv[++i]);
+			isElitesSet = true;
+		}
+		else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+		{
+			settings.games = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--round") == 0 && i + 1 < argc)
+		{
+			settings.round = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--pieces") == 0 && i + 1 < argc)
+		{
+			settings.pieces = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--cutoff") == 0 && i + 1 < argc)
+		{
+			settings.cutoff = std::atof(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			settings.seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--randomizer") == 0 && i + 1 < argc)
+		{
+			if (!ParseRandomizer(argv[++i], settings.randomizerKind))
+			{
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			settings.threads = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--lookahead") == 0)
+		{
+			settings.useLookahead = true;
+		}
+		else if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+		{
+			settings.checkpointPath = argv[++i];
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if (!isElitesSet)
+	{
+		settings.elites = std::max(1, settings.population / 4);
+	}
+
+	if (settings.population < 2 || settings.elites < 1 || settings.elites > settings.population
+		|| settings.games < 1 || settings.round < 1 || settings.pieces < 1 || settings.threads < 1)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	TunerState state{};
+
+	state.mean = ToVector(EvaluationWeights{});
+	Normalize(state.mean);
+	state.spread.fill(INITIAL_SPREAD);
+
+	if (settings.checkpointPath != nullptr && std::ifstream{ settings.checkpointPath })
+	{
+		if (!LoadCheckpoint(settings.checkpointPath, state))
+		{
+			return 1;
+		}
+
+		state.generation++;
+		std::cout << "resuming " << settings.checkpointPath << " at generation " << state.generation << "\n";
+	}
+
+	Tuner tuner{ settings };
+	long long totalGames{}, totalPieces{};
+	double totalSeconds{};
+
+	std::cout << "threads " << tuner.GetThreadCount()
+		<< "  population " << settings.population
+		<< "  elites " << settings.elites
+		<< "  games " << settings.games
+		<< "  pieces " << settings.pieces << "\n";
+
+	for (; state.generation < settings.generations; state.generation++)
+	{
+		auto start{ std::chrono::steady_clock::now() };
+		double busySeconds{ tuner.GetBusySeconds() };
+
+		state.population = SamplePopulation(settings, state);
+
+		long long games{ tuner.EvaluatePopulation(state) };
+		long long pieces{};
+		int dropped{};
+		double totalFitness{};
+
+		for (const Candidate& candidate : state.population)
+		{
+			pieces += candidate.pieces;
+			dropped += candidate.isDropped ? 1 : 0;
+			totalFitness += candidate.GetFitness();
+		}
+
+		UpdateDistribution(settings, state);
+
+		std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+		double busy{ (tuner.GetBusySeconds() - busySeconds) / (elapsed.count() * tuner.GetThreadCount()) };
+
+		totalGames += games;
+		totalPieces += pieces;
+		totalSeconds += elapsed.count();
+
+		std::cout << "generation " << state.generation
+			<< "  best " << state.population[0].GetFitness()
+			<< "  average " << totalFitness / state.population.size()
+			<< "  dropped " << dropped
+			<< "  games/s " << games / elapsed.count()
+			<< "  pieces/s " << pieces / elapsed.count()
+			<< "  busy " << (int)(busy * 100) << "%\n"
+			<< "  mean";
+
+		for (double weight : state.mean)
+		{
+			std::cout << " " << weight;
+		}
+
+		std::cout << "\n";
+
+		if (settings.checkpointPath != nullptr && !SaveCheckpoint(settings.checkpointPath, state))
+		{
+			return 1;
+		}
+	}
+
+	EvaluationWeights best{ ToWeights(state.bestWeights) };
+
+	std::cout << "best lines/game " << state.bestFitness << "\n"
+		<< "  aggregateHeight " << best.aggregateHeight << "\n"
+		<< "  holes           " << best.holes << "\n"
+		<< "  bumpiness       " << best.bumpiness << "\n"
+		<< "  wells           " << best.wells << "\n"
+		<< "  clearedLines    " << best.clearedLines << "\n";
+
+	if (totalSeconds > 0)
+	{
+		std::cout << "games:    " << totalGames << "\n"
+			<< "pieces:   " << totalPieces << "\n"
+			<< "seconds:  " << totalSeconds << "\n"
+			<< "games/s:  " << totalGames / totalSeconds << "\n"
+			<< "pieces/s: " << totalPieces / totalSeconds << "\n";
+	}
+
+	return 0;
+}
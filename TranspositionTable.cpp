@@ -0,0 +1,140 @@
+#include "TranspositionTable.h"
+#include <cstring>
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const uint64_t
+			KEY_MASK{ ~0xFFFFull },
+			GENERATION_SHIFT{ 8 },
+			DEPTH_MASK{ 0xFF };
+
+		uint64_t ToBits(double value)
+		{
+			uint64_t bits{};
+
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			return bits;
+		}
+
+		double FromBits(uint64_t bits)
+		{
+			double value{};
+
+			std::memcpy(&value, &bits, sizeof(value));
+
+			return value;
+		}
+	}
+
+	TranspositionTable::TranspositionTable(size_t megabytes)
+	{
+		Resize(megabytes);
+	}
+
+	void TranspositionTable::Resize(size_t megabytes)
+	{
+		size_t bucketCount{ 1 };
+
+		// The largest power of two that fits, at least one bucket.
+		while (bucketCount * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+		{
+			bucketCount *= 2;
+		}
+
+		buckets = std::make_unique<Bucket[]>(bucketCount);
+		bucketMask = bucketCount - 1;
+		Clear();
+	}
+
+	void TranspositionTable::Clear()
+	{
+		for (size_t i{}; i <= bucketMask; i++)
+		{
+			for (int j{}; j < TRANSPOSITION_BUCKET_ENTRIES; j++)
+			{
+				buckets[i].keys[j].store(0, std::memory_order_relaxed);
+				buckets[i].values[j].store(0, std::memory_order_relaxed);
+			}
+		}
+
+		generation = 0;
+	}
+
+	void TranspositionTable::NewGeneration()
+	{
+		generation++;
+	}
+
+	bool TranspositionTable::Probe(uint64_t key, int depth, double& value) const
+	{
+		const Bucket& bucket{ *GetBucket(key) };
+
+		for (int i{}; i < TRANSPOSITION_BUCKET_ENTRIES; i++)
+		{
+			uint64_t storedKey{ bucket.keys[i].load(std::memory_order_relaxed) };
+			uint64_t storedValue{ bucket.values[i].load(std::memory_order_relaxed) };
+
+			if (((storedKey ^ storedValue ^ key) & KEY_MASK) == 0 && storedKey != 0
+				&& (int)(storedKey & DEPTH_MASK) >= depth)
+			{
+				value = FromBits(storedValue);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void TranspositionTable::Store(uint64_t key, int depth, double value)
+	{
+		Bucket& bucket{ *GetBucket(key) };
+		uint64_t bits{ ToBits(value) };
+		int victim{};
+		int victimPriority{ 1 << 30 };
+
+		for (int i{}; i < TRANSPOSITION_BUCKET_ENTRIES; i++)
+		{
+			uint64_t storedKey{ bucket.keys[i].load(std::memory_order_relaxed) };
+			uint64_t storedValue{ bucket.values[i].load(std::memory_order_relaxed) };
+
+			if (storedKey == 0 || ((storedKey ^ storedValue ^ key) & KEY_MASK) == 0)
+			{
+				victim = i;
+				break;
+			}
+
+			bool isCurrent{ (uint8_t)(storedKey >> GENERATION_SHIFT) == generation };
+			int priority{ (int)(storedKey & DEPTH_MASK) + (isCurrent ? 256 : 0) };
+
+			if (priority < victimPriority)
+			{
+				victim = i;
+				victimPriority = priority;
+			}
+		}
+
+		uint64_t storedKey{ ((key ^ bits) & KEY_MASK) | (uint64_t)generation << GENERATION_SHIFT
+			| ((uint64_t)depth & DEPTH_MASK) };
+
+		bucket.keys[victim].store(storedKey, std::memory_order_relaxed);
+		bucket.values[victim].store(bits, std::memory_order_relaxed);
+	}
+
+	size_t TranspositionTable::GetMemoryBytes() const
+	{
+		return (bucketMask + 1) * sizeof(Bucket);
+	}
+
+	size_t TranspositionTable::GetEntryCount() const
+	{
+		return (bucketMask + 1) * TRANSPOSITION_BUCKET_ENTRIES;
+	}
+
+	TranspositionTable::Bucket* TranspositionTable::GetBucket(uint64_t key) const
+	{
+		return &buckets[key & bucketMask];
+	}
+}
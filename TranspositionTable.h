@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace GameNamespace
+{
+	const int TRANSPOSITION_BUCKET_ENTRIES{ 4 };
+
+	const size_t TRANSPOSITION_TABLE_MEGABYTES{ 16 };
+
+	// A fixed-size hash table of search values, shared by threads without
+	// locks. Every bucket is one cache line of four entries. An entry keeps
+	// the value and, XORed with it, the upper 48 bits of the key; the lower
+	// 16 bits hold the search depth and the generation. A write torn by
+	// another thread makes the key check fail, so a probe never returns a
+	// value stored for another key.
+	//
+	// A store replaces the entry of the same key, else an empty one, else
+	// the entry from the oldest search with the smallest depth.
+	class TranspositionTable
+	{
+	public:
+		explicit TranspositionTable(size_t megabytes = TRANSPOSITION_TABLE_MEGABYTES);
+
+		void Clear();
+		// Called once per search; entries of earlier searches are replaced
+		// first.
+		void NewGeneration();
+
+		// Only values stored with at least depth count.
+		bool Probe(uint64_t key, int depth, double& value) const;
+		void Store(uint64_t key, int depth, double value);
+
+		size_t GetMemoryBytes() const;
+		size_t GetEntryCount() const;
+
+	private:
+		struct alignas(64) Bucket
+		{
+			std::atomic<uint64_t> keys[TRANSPOSITION_BUCKET_ENTRIES];
+			std::atomic<uint64_t> values[TRANSPOSITION_BUCKET_ENTRIES];
+		};
+
+		std::unique_ptr<Bucket[]> buckets{};
+		size_t bucketMask{};
+		uint8_t generation{};
+
+		void Resize(size_t megabytes);
+		Bucket* GetBucket(uint64_t key) const;
+	};
+}
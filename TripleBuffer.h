@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace GameNamespace
+{
+	// Hands the newest value from one writer thread to one reader thread
+	// without locks or waiting. The writer fills its own slot and swaps it
+	// with the middle one; the reader swaps its slot with the middle one only
+	// when that holds something newer. Neither ever touches the other's slot,
+	// and a value the reader missed is simply overwritten.
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+		TripleBuffer() = default;
+
+		TripleBuffer(const TripleBuffer&) = delete;
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+		T& GetWriteSlot()
+		{
+			return slots[back].value;
+		}
+
+		void Publish()
+		{
+			back = middle.exchange((uint8_t)(back | FRESH_BIT), std::memory_order_acq_rel) & INDEX_MASK;
+		}
+
+		// Whether a value has been published that Read has not returned yet.
+		bool HasNewValue() const
+		{
+			return (middle.load(std::memory_order_relaxed) & FRESH_BIT) != 0;
+		}
+
+		// The newest published value, or the last one read again when nothing
+		// has been published since.
+		const T& Read()
+		{
+			if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) != 0)
+			{
+				front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+			}
+
+			return slots[front].value;
+		}
+
+	private:
+		static const uint8_t
+			INDEX_MASK{ 3 },
+			FRESH_BIT{ 4 };
+
+		struct alignas(64) Slot
+		{
+			T value{};
+		};
+
+		Slot slots[3]{};
+		alignas(64) std::atomic<uint8_t> middle{ 1 };
+		alignas(64) uint8_t back{ 0 };
+		alignas(64) uint8_t front{ 2 };
+	};
+}
@@ -0,0 +1,180 @@
+#include "VectorEnvironment.h"
+#include <array>
+
+namespace GameNamespace
+{
+	namespace
+	{
+		const BoardRow COLUMNS_MASK{ (1 << OBSERVATION_COLUMNS) - 1 };
+
+		typedef std::array<std::array<BoardRow, OBSERVATION_ROWS>, OBSERVATION_PLANES> ObservationPlanes;
+
+		// Bit x + 1 of a board row is column x, the left wall being bit 0.
+		BoardRow ToObservationRow(BoardRow row)
+		{
+			return (BoardRow)(row >> 1 & COLUMNS_MASK);
+		}
+
+		void AddPiece(std::array<BoardRow, OBSERVATION_ROWS>& plane, FigureKind figure, size_t rotation,
+			PiecePosition position)
+		{
+			const PieceMask& mask{ PIECE_MASKS[static_cast<int>(figure)][rotation][position.x - MIN_PIECE_X] };
+
+			for (int i{}; i < MAX_PIECE_SIZE; i++)
+			{
+				int row{ position.y + i };
+
+				if (row >= 0 && row < OBSERVATION_ROWS)
+				{
+					plane[row] |= ToObservationRow(mask.rows[i]);
+				}
+			}
+		}
+	}
+
+	VectorEnvironment::VectorEnvironment(int count, int threads, uint64_t seed, RandomizerKind randomizerKind)
+		: count{ count }, seed{ seed }, randomizerKind{ randomizerKind }, pool{ threads },
+		boards(count), profiles(count), randomizers(count), seeds(count), currentFigures(count), nextFigures(count),
+		rotations(count), nextRotations(count), positions(count), currentFrames(count), scores(count),
+		lockedPieces(count), clearedLines(count), boardVersions(count), gameOvers{ new bool[count]{} },
+		episodes(count)
+	{
+		for (int i{}; i < count; i++)
+		{
+			ResetGame(i);
+		}
+	}
+
+	int VectorEnvironment::GetCount() const
+	{
+		return count;
+	}
+
+	int VectorEnvironment::GetThreadCount() const
+	{
+		return pool.GetThreadCount();
+	}
+
+	long long VectorEnvironment::GetSteps() const
+	{
+		return steps;
+	}
+
+	long long VectorEnvironment::GetEpisodes() const
+	{
+		long long total{};
+
+		for (long long gameEpisodes : episodes)
+		{
+			total += gameEpisodes;
+		}
+
+		return total;
+	}
+
+	const Bitboard& VectorEnvironment::GetBoard(int index) const
+	{
+		return boards[index];
+	}
+
+	PiecePosition VectorEnvironment::GetPosition(int index) const
+	{
+		return positions[index];
+	}
+
+	long long VectorEnvironment::GetLockedPieces(int index) const
+	{
+		return lockedPieces[index];
+	}
+
+	void VectorEnvironment::Reset(uint8_t* observations)
+	{
+		auto task
+		{
+			[&](int worker)
+			{
+				for (int i{ GetSliceBegin(worker) }; i < GetSliceBegin(worker + 1); i++)
+				{
+					episodes[i] = 0;
+					ResetGame(i);
+					WriteObservation(i, observations + (size_t)i * OBSERVATION_SIZE);
+				}
+			}
+		};
+
+		pool.Run(task);
+		steps = 0;
+	}
+
+	void VectorEnvironment::Step(const PieceMovement* actions, uint8_t* observations, float* rewards, uint8_t* dones)
+	{
+		auto task
+		{
+			[&](int worker)
+			{
+				for (int i{ GetSliceBegin(worker) }; i < GetSliceBegin(worker + 1); i++)
+				{
+					long long previousLines{ clearedLines[i] };
+
+					Engine::Tick(GetFields(i), actions[i]);
+
+					rewards[i] = (float)(clearedLines[i] - previousLines);
+					dones[i] = gameOvers[i] ? 1 : 0;
+
+					if (dones[i])
+					{
+						episodes[i]++;
+						ResetGame(i);
+					}
+
+					WriteObservation(i, observations + (size_t)i * OBSERVATION_SIZE);
+				}
+			}
+		};
+
+		pool.Run(task);
+		steps++;
+	}
+
+	EngineFields VectorEnvironment::GetFields(int index)
+	{
+		return { boards[index], profiles[index], randomizers[index], seeds[index], currentFigures[index],
+			nextFigures[index], rotations[index], nextRotations[index], positions[index], currentFrames[index],
+			scores[index], lockedPieces[index], clearedLines[index], boardVersions[index], gameOvers[index] };
+	}
+
+	void VectorEnvironment::ResetGame(int index)
+	{
+		// Every game and episode gets a seed of its own.
+		Engine::Reset(GetFields(index), seed + (uint64_t)episodes[index] * count + index, randomizerKind);
+	}
+
+	void VectorEnvironment::WriteObservation(int index, uint8_t* observation) const
+	{
+		const Bitboard& board{ boards[index] };
+		ObservationPlanes planes{};
+
+		for (int row{}; row < OBSERVATION_ROWS; row++)
+		{
+			planes[0][row] = ToObservationRow(board.GetRow(row));
+		}
+
+		AddPiece(planes[1], currentFigures[index], rotations[index], positions[index]);
+		AddPiece(planes[2], nextFigures[index], nextRotations[index], { PIECE_INITIAL_COLUMN, PIECE_INITIAL_ROW });
+		planes[OBSERVATION_ROTATION_PLANE + rotations[index]].fill(COLUMNS_MASK);
+
+		for (const auto& plane : planes)
+		{
+			for (BoardRow row : plane)
+			{
+				*observation++ = (uint8_t)row;
+				*observation++ = (uint8_t)(row >> 8);
+			}
+		}
+	}
+
+	int VectorEnvironment::GetSliceBegin(int worker) const
+	{
+		return (int)((long long)count * worker / pool.GetThreadCount());
+	}
+}
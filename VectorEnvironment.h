@@ -0,0 +1,90 @@
+#pragma once
+#include "Engine.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GameNamespace
+{
+	const int
+		OBSERVATION_COLUMNS{ BOARD_WIDTH_IN_BLOCKS - 2 },
+		OBSERVATION_ROWS{ BOARD_HEIGHT_IN_BLOCKS - 1 },
+		OBSERVATION_ROW_BYTES{ 2 },
+		OBSERVATION_PLANE_SIZE{ OBSERVATION_ROWS * OBSERVATION_ROW_BYTES },
+		OBSERVATION_ROTATION_PLANE{ 3 },
+		OBSERVATION_PLANES{ OBSERVATION_ROTATION_PLANE + PIECE_ROTATIONS },
+		OBSERVATION_SIZE{ OBSERVATION_PLANES * OBSERVATION_PLANE_SIZE },
+		ACTION_COUNT{ static_cast<int>(PieceMovement::HardDrop) + 1 };
+
+	static_assert(OBSERVATION_COLUMNS <= OBSERVATION_ROW_BYTES * 8, "An observation row must fit its bytes");
+
+	// Runs count independent games in lockstep for training agents. Every
+	// step applies one PieceMovement per game for one logic tick. A game
+	// that ends is reset at once with a fresh seed, reports done and its
+	// next observation is already that of the new game.
+	//
+	// The caller owns the output buffers. Observation i takes OBSERVATION_SIZE
+	// bytes at observations + i * OBSERVATION_SIZE: bit planes of the cells
+	// inside the walls. A plane is OBSERVATION_ROWS rows, top row first, and
+	// a row is OBSERVATION_ROW_BYTES bytes, low byte first, bit c being
+	// column c. The planes are the locked blocks, the falling piece, the next
+	// piece at its spawn position, and one plane per rotation, the one of the
+	// falling piece all ones. The reward of a step is the number of lines it
+	// cleared.
+	//
+	// The games are kept as a structure of arrays, one array per field of
+	// an Engine, and stepped through EngineFields. They are split into one
+	// contiguous slice per thread of a pool; nothing is allocated after
+	// construction. Every game is already seeded when the constructor
+	// returns, so Step may come before the first Reset.
+	class VectorEnvironment
+	{
+	public:
+		VectorEnvironment(int count, int threads, uint64_t seed = 0,
+			RandomizerKind randomizerKind = RandomizerKind::Uniform);
+
+		int GetCount() const;
+		int GetThreadCount() const;
+		long long GetSteps() const;
+		long long GetEpisodes() const;
+		const Bitboard& GetBoard(int index) const;
+		PiecePosition GetPosition(int index) const;
+		long long GetLockedPieces(int index) const;
+
+		// Starts every game over and counts steps and episodes from zero.
+		void Reset(uint8_t* observations);
+		void Step(const PieceMovement* actions, uint8_t* observations, float* rewards, uint8_t* dones);
+
+	private:
+		int count{};
+		uint64_t seed{};
+		RandomizerKind randomizerKind{};
+		ThreadPool pool;
+
+		std::vector<Bitboard> boards{};
+		std::vector<BoardProfile> profiles{};
+		std::vector<PieceRandomizer> randomizers{};
+		std::vector<uint64_t> seeds{};
+		std::vector<FigureKind> currentFigures{};
+		std::vector<FigureKind> nextFigures{};
+		std::vector<size_t> rotations{};
+		std::vector<size_t> nextRotations{};
+		std::vector<PiecePosition> positions{};
+		std::vector<int> currentFrames{};
+		std::vector<int> scores{};
+		std::vector<long long> lockedPieces{};
+		std::vector<long long> clearedLines{};
+		std::vector<long long> boardVersions{};
+		// std::vector<bool> packs bits and cannot hand out a bool&.
+		std::unique_ptr<bool[]> gameOvers{};
+
+		std::vector<long long> episodes{};
+		long long steps{};
+
+		EngineFields GetFields(int index);
+		void ResetGame(int index);
+		void WriteObservation(int index, uint8_t* observation) const;
+		int GetSliceBegin(int worker) const;
+	};
+}
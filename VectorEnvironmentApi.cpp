@@ -0,0 +1,80 @@
+#include "VectorEnvironmentApi.h"
+#include "VectorEnvironment.h"
+#include <exception>
+#include <thread>
+
+using namespace GameNamespace;
+
+struct TetrisVectorEnvironment
+{
+	VectorEnvironment environment;
+	std::vector<PieceMovement> actions{};
+};
+
+TetrisVectorEnvironment* TetrisCreateVectorEnvironment(int count, int threads, uint64_t seed)
+{
+	if (count < 1 || threads < 0)
+	{
+		return nullptr;
+	}
+
+	if (threads == 0)
+	{
+		threads = (int)std::thread::hardware_concurrency();
+	}
+
+	try
+	{
+		TetrisVectorEnvironment* environment{ new TetrisVectorEnvironment{ { count, threads < 1 ? 1 : threads, seed } } };
+
+		environment->actions.resize(count);
+
+		return environment;
+	}
+	catch (const std::exception&)
+	{
+		return nullptr;
+	}
+}
+
+void TetrisDestroyVectorEnvironment(TetrisVectorEnvironment* environment)
+{
+	delete environment;
+}
+
+int TetrisGetObservationSize(void)
+{
+	return OBSERVATION_SIZE;
+}
+
+int TetrisGetObservationShape(int* planes, int* rows, int* columns)
+{
+	*planes = OBSERVATION_PLANES;
+	*rows = OBSERVATION_ROWS;
+	*columns = OBSERVATION_COLUMNS;
+
+	return OBSERVATION_SIZE;
+}
+
+int TetrisGetActionCount(void)
+{
+	return ACTION_COUNT;
+}
+
+void TetrisReset(TetrisVectorEnvironment* environment, uint8_t* observations)
+{
+	environment->environment.Reset(observations);
+}
+
+void TetrisStep(TetrisVectorEnvironment* environment, const int32_t* actions,
+	uint8_t* observations, float* rewards, uint8_t* dones)
+{
+	for (size_t i{}; i < environment->actions.size(); i++)
+	{
+		environment->actions[i] = actions[i] >= 0 && actions[i] < ACTION_COUNT
+			? (PieceMovement)actions[i]
+			: PieceMovement::None;
+	}
+
+	environment->environment.Step(environment->actions.data(), observations, rewards, dones);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * C interface to VectorEnvironment, for training code that loads the
+ * TetrisEnvironment shared library through a foreign function interface.
+ * Actions are PieceMovement values: 0 none, 1 left, 2 right, 3 rotate,
+ * 4 speed up and 5 hard drop; anything else counts as none. The buffers
+ * are described in VectorEnvironment.h.
+ */
+
+#if defined(_WIN32) && defined(TETRIS_ENVIRONMENT_EXPORTS)
+#define TETRIS_ENVIRONMENT_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define TETRIS_ENVIRONMENT_API __declspec(dllimport)
+#else
+#define TETRIS_ENVIRONMENT_API
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct TetrisVectorEnvironment TetrisVectorEnvironment;
+
+/* Returns NULL if the environments cannot be created. threads 0 uses one
+ * thread per core. */
+TETRIS_ENVIRONMENT_API TetrisVectorEnvironment* TetrisCreateVectorEnvironment(int count, int threads, uint64_t seed);
+TETRIS_ENVIRONMENT_API void TetrisDestroyVectorEnvironment(TetrisVectorEnvironment* environment);
+
+/* Observations are packed bit planes; the shape is in bits and both return
+ * the bytes of one observation. */
+TETRIS_ENVIRONMENT_API int TetrisGetObservationSize(void);
+TETRIS_ENVIRONMENT_API int TetrisGetObservationShape(int* planes, int* rows, int* columns);
+TETRIS_ENVIRONMENT_API int TetrisGetActionCount(void);
+
+TETRIS_ENVIRONMENT_API void TetrisReset(TetrisVectorEnvironment* environment, uint8_t* observations);
+TETRIS_ENVIRONMENT_API void TetrisStep(TetrisVectorEnvironment* environment, const int32_t* actions,
+	uint8_t* observations, float* rewards, uint8_t* dones);
+
+#ifdef __cplusplus
+}
+#endif
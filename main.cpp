@@ -1,32 +1,107 @@
 #include "Game.h"
 #include "GameExceptions.h"
+#include "FixedTimestep.h"
 #include <memory>
 #include <string>
 
 using GameNamespace::Game;
+using GameNamespace::FixedTimestep;
 
 int main(int argc, char* argv[])
 {
-    Uint32 frameStart{};
-    int frameTime{};
-
     try
     {
-        std::unique_ptr<Game> game{ new Game() };
+        GameNamespace::RenderOptions options{};
+        const char* replayFilePath{};
+        const char* bridgeName{};
+
+        for (int i{ 1 }; i < argc; i++)
+        {
+            std::string argument{ argv[i] };
+
+            if (argument == "--opengl")
+            {
+                options.backend = GameNamespace::RenderBackend::OpenGL;
+            }
+            else if (argument == "--vsync")
+            {
+                options.isVSync = true;
+            }
+            else if (argument == "--fps" && i + 1 < argc)
+            {
+                options.framesPerSecond = SDL_atoi(argv[++i]);
+            }
+            else if (argument == "--replay" && i + 1 < argc)
+            {
+                replayFilePath = argv[++i];
+            }
+            else if (argument == "--bridge" && i + 1 < argc)
+            {
+                bridgeName = argv[++i];
+            }
+        }
+
+        std::unique_ptr<Game> game{ new Game(options) };
 
+        if (replayFilePath != nullptr)
+        {
+            game->StartReplay(replayFilePath);
+        }
+        else if (bridgeName != nullptr)
+        {
+            game->StartBridge(bridgeName);
+        }
+
+        FixedTimestep timestep{ GameNamespace::LOGIC_TICKS_PER_SECOND, GameNamespace::MAX_TICKS_PER_FRAME };
+
+        bool isIdleSnapshotCurrent{};
+
+        // This thread handles input and runs the logic ticks. With OpenGL the
+        // game draws on its own thread, so a slow present never delays them;
+        // otherwise a frame is drawn here whenever one is due.
         while (game->IsRunning())
         {
-            frameStart = SDL_GetTicks();
+            // On a screen where nothing moves, sleep until an event comes in
+            // and publish only what it changed.
+            if (game->IsIdle())
+            {
+                if (!isIdleSnapshotCurrent)
+                {
+                    game->PublishSnapshot(0);
+                    isIdleSnapshotCurrent = true;
+                }
+
+                game->RenderFrame();
+
+                if (game->WaitForEvents(GameNamespace::IDLE_WAIT_MILLISECONDS))
+                {
+                    isIdleSnapshotCurrent = false;
+                }
+
+                timestep.Reset();
+                continue;
+            }
+
+            isIdleSnapshotCurrent = false;
 
             game->HandleEvents();
-            game->Update();
-            game->Render();
 
-            frameTime = SDL_GetTicks() - frameStart;
+            int ticks{ timestep.Advance() };
+
+            for (int i{}; i < ticks; i++)
+            {
+                game->Update();
+            }
+
+            if (ticks > 0)
+            {
+                game->PublishSnapshot(timestep.GetInterpolation());
+            }
 
-            if (game->GetFrameDelay() > frameTime)
+            // A drawn frame has already waited for its turn.
+            if (!game->RenderFrame())
             {
-                SDL_Delay(game->GetFrameDelay() - frameTime);
+                SDL_Delay(timestep.GetMillisecondsToNextTick());
             }
         }
     }